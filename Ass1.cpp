@@ -5,54 +5,158 @@
 // Create a hash table of size 10.
 // 1. Linear probing with chaining without replacement: Insert the following RollNos:
 // (31,13,14,51,16,71,48,19)
+// Usage: ./a.out                          the test case above
+//        ./a.out size [bulk [snapshot]]   also the benchmarks: lookups at 80% load of a
+//                                         table of size, bulk load of bulk records (10M),
+//                                         same-home chains, snapshot of snapshot records (1M)
 
 #include <iostream>
+#include <vector>
+#include <chrono>
+#include <random>
+#include <algorithm>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
 using namespace std;
 
 const int SIZE = 10;
+const char* SNAPSHOT_FILE = "students_hash.dat";
 
 struct Student {
     int rollNo;
     int marks;
     int link;
     bool occupied;
+    bool deleted;   // tombstone: record removed but slot still part of a chain
 
     Student() {
         rollNo = -1;
         marks = 0;
         link = -1;
         occupied = false;
+        deleted = false;
     }
 };
 
+// Snapshot file: this header followed by the slot array exactly as it is in memory
+struct SnapshotHeader {
+    char magic[8];
+    int slotSize;   // sizeof(Student) of the program that wrote it
+    int size;       // number of slots
+};
+
+const char SNAPSHOT_MAGIC[8] = "HTSNAP1";
+
 class HashTable {
-    Student table[SIZE];
+    vector<Student> table;
+    vector<int> tail;       // per home slot: last known slot of the chain from it
+    vector<int> tailEpoch;  // a cached tail is valid only if its epoch is current
+    int epoch = 0;          // bumped whenever a slot is taken out of a chain
+    int tombstones = 0;
+    vector<int> chainTombstones;    // per home slot: tombstones of records with that home
 
     int hashFunction(int rollNo) {
-        return rollNo % SIZE;
+        return rollNo % (int)table.size();
+    }
+
+    bool isFree(int i) {
+        return !table[i].occupied && !table[i].deleted;
+    }
+
+    // Re-insert all live records into a clean table; false if there are no tombstones to drop
+    bool rebuild() {
+        vector<Student> live;
+        for (const Student& s : table)
+            if (s.occupied)
+                live.push_back(s);
+        if (live.size() == table.size())
+            return false;
+
+        table.assign(table.size(), Student());
+        tombstones = 0;
+        fill(chainTombstones.begin(), chainTombstones.end(), 0);
+        ++epoch;
+        for (const Student& s : live)
+            insert(s.rollNo, s.marks);
+        return true;
+    }
+
+    // Last slot of the chain from home. The cached tail is always on that chain, so only
+    // records appended after it (through a chain merged into this one) are walked.
+    int chainTail(int home) {
+        int j = tailEpoch[home] == epoch ? tail[home] : home;
+        while (table[j].link != -1)
+            j = table[j].link;
+        return j;
+    }
+
+    void setTail(int home, int j) {
+        tail[home] = j;
+        tailEpoch[home] = epoch;
+    }
+
+    // The per-home arrays are left empty by build() until an insert or remove needs them
+    void sizeChainState() {
+        int size = (int)table.size();
+        if ((int)tail.size() != size) {
+            tail.assign(size, 0);
+            tailEpoch.assign(size, -1);
+            chainTombstones.assign(size, 0);
+        }
     }
 
 public:
+    HashTable(int size = SIZE)
+        : table(size), tail(size), tailEpoch(size, -1), chainTombstones(size, 0) {}
+
     // Insert a roll number and marks into the hash table
     void insert(int rollNo, int marks) {
+        int size = (int)table.size();
         int index = hashFunction(rollNo);
+        sizeChainState();
 
         // Case 1: Home slot is empty
-        if (!table[index].occupied) {
+        if (isFree(index)) {
             table[index].rollNo = rollNo;
             table[index].marks = marks;
             table[index].occupied = true;
+            setTail(index, index);
             return;
         }
 
-        // Case 2: Home slot is occupied — find next free slot
-        int i = (index + 1) % SIZE;
-        while (i != index && table[i].occupied) {
-            i = (i + 1) % SIZE;
+        // A tombstone already on the chain from home can be reused as is. Only chains that hold
+        // a tombstone of their own home are walked; others go straight to the cached tail.
+        for (int t = index; chainTombstones[index] > 0 && t != -1; t = table[t].link) {
+            if (table[t].deleted) {
+                --chainTombstones[hashFunction(table[t].rollNo)];
+                table[t].rollNo = rollNo;
+                table[t].marks = marks;
+                table[t].occupied = true;
+                table[t].deleted = false;
+                --tombstones;
+                return;
+            }
+        }
+
+        // Case 2: Home slot is occupied — find next free slot, probing on from the chain
+        // tail since the slots up to it were already taken when the tail was placed
+        int j = chainTail(index);
+        int i = (j + 1) % size;
+        while (i != j && !isFree(i)) {
+            i = (i + 1) % size;
         }
 
-        if (i == index) {
-            cout << "Hash table is full!\n";
+        if (i == j) {
+            // Only tombstones left to reuse: rebuild the chains without them and retry
+            if (rebuild())
+                insert(rollNo, marks);
+            else
+                cout << "Hash table is full!\n";
             return;
         }
 
@@ -61,27 +165,372 @@ public:
         table[i].marks = marks;
         table[i].occupied = true;
 
-        // Chain from home slot (without replacement)
-        int j = index;
-        while (table[j].link != -1) {
+        // Chain from home slot (without replacement), j is the chain tail
+        table[j].link = i;
+        setTail(index, i);
+    }
+
+    // Bulk load (rollNo, marks) pairs, replacing the current contents. The table keeps its
+    // capacity, growing once if needed for an 80% load, and the records are bucketed by which
+    // block of slots their home is in, so the writes for one bucket stay in cache. Home slots
+    // are filled first; then each bucket's remaining records are sorted by home and laid out
+    // with a free-slot cursor that only moves forward, chaining each one from the previous
+    // record of the same home.
+    template <class Iterator>
+    void build(Iterator begin, Iterator end) {
+        const int BLOCK_BITS = 15;
+        const int BLOCK = 1 << BLOCK_BITS;
+        int n = (int)distance(begin, end);
+        int size = max((int)table.size(), (int)(n / 0.8) + 1);
+        int blocks = ((size - 1) >> BLOCK_BITS) + 1;
+        table.assign(size, Student());
+        tail.clear();
+        tailEpoch.clear();
+        chainTombstones.clear();
+        tombstones = 0;
+
+        struct Record {
+            int home;
+            int rollNo;
+            int marks;
+        };
+
+        // Bucket the records by block with one counting pass and one scatter pass
+        vector<int> start(blocks + 1, 0);
+        for (Iterator it = begin; it != end; ++it)
+            ++start[(hashFunction(it->first) >> BLOCK_BITS) + 1];
+        for (int b = 0; b < blocks; ++b)
+            start[b + 1] += start[b];
+
+        vector<Record> records(n);
+        vector<int> fill(start.begin(), start.end() - 1);
+        for (Iterator it = begin; it != end; ++it) {
+            int home = hashFunction(it->first);
+            records[fill[home >> BLOCK_BITS]++] = {home, it->first, it->second};
+        }
+
+        // Each home slot takes the first record of its block that hashes to it; the others
+        // are moved to the front of the block's bucket
+        vector<int> overflowEnd(blocks);
+        auto placeHomes = [&](int b) {
+            int out = start[b];
+            for (int p = start[b]; p < start[b + 1]; ++p) {
+                Student& s = table[records[p].home];
+                if (s.occupied) {
+                    records[out++] = records[p];
+                    continue;
+                }
+                s.rollNo = records[p].rollNo;
+                s.marks = records[p].marks;
+                s.occupied = true;
+            }
+            overflowEnd[b] = out;
+        };
+
+        // Remaining records of a block in home order: next free slot after the home, chained
+        // from the previous record of that home. The homes of the next block are placed
+        // first, so the block's slots are still in cache and spills cannot take a home slot.
+        vector<int> count(BLOCK + 1);
+        vector<Record> sorted;
+        int cursor = 0;
+        bool wrapped = false;
+        placeHomes(0);
+        for (int b = 0; b < blocks; ++b) {
+            if (b + 1 < blocks)
+                placeHomes(b + 1);
+            int base = b << BLOCK_BITS;
+            fill_n(count.begin(), BLOCK + 1, 0);
+            for (int p = start[b]; p < overflowEnd[b]; ++p)
+                ++count[records[p].home - base + 1];
+            for (int t = 0; t < BLOCK; ++t)
+                count[t + 1] += count[t];
+            sorted.resize(overflowEnd[b] - start[b]);
+            for (int p = start[b]; p < overflowEnd[b]; ++p)
+                sorted[count[records[p].home - base]++] = records[p];
+
+            for (size_t p = 0; p < sorted.size(); ++p) {
+                int h = sorted[p].home;
+                int tail = h;
+                if (p > 0 && sorted[p - 1].home == h)
+                    tail = cursor;
+                else if (!wrapped && cursor <= h)
+                    cursor = h;
+                while (table[cursor].occupied) {
+                    if (++cursor == size) {
+                        cursor = 0;
+                        wrapped = true;
+                    }
+                }
+                if (tail == h)
+                    while (table[tail].link != -1)
+                        tail = table[tail].link;
+                table[cursor].rollNo = sorted[p].rollNo;
+                table[cursor].marks = sorted[p].marks;
+                table[cursor].occupied = true;
+                table[tail].link = cursor;
+            }
+        }
+    }
+
+    // Look up marks for a roll number by following the chain from its home slot
+    bool search(int rollNo, int& marks) {
+        int j = hashFunction(rollNo);
+        if (isFree(j))
+            return false;
+
+        while (j != -1) {
+            if (table[j].occupied && table[j].rollNo == rollNo) {
+                marks = table[j].marks;
+                return true;
+            }
             j = table[j].link;
         }
-        table[j].link = i;
+        return false;
+    }
+
+    // Delete a roll number. The slot becomes a tombstone so chains passing through it
+    // stay intact; tombstones left at the end of the chain are unlinked and freed.
+    bool remove(int rollNo) {
+        vector<int> path;   // slots visited from the home slot
+        int j = hashFunction(rollNo);
+        if (isFree(j))
+            return false;
+
+        while (j != -1) {
+            path.push_back(j);
+            if (table[j].occupied && table[j].rollNo == rollNo)
+                break;
+            j = table[j].link;
+        }
+        if (j == -1)
+            return false;
+
+        sizeChainState();
+        table[j].occupied = false;
+        table[j].deleted = true;
+        ++tombstones;
+        ++chainTombstones[hashFunction(rollNo)];
+
+        // Repair the chain: a tombstone at the tail is not needed by any lookup
+        while (path.size() > 1) {
+            int last = path.back();
+            if (!table[last].deleted || table[last].link != -1)
+                break;
+            path.pop_back();
+            table[path.back()].link = -1;
+            --chainTombstones[hashFunction(table[last].rollNo)];
+            table[last] = Student();
+            --tombstones;
+            ++epoch;
+        }
+        return true;
+    }
+
+    // Write the slot array (links included) to a flat file that MappedHashTable can open
+    bool save(const char* path) {
+        ofstream file(path, ios::binary | ios::trunc);
+        if (!file)
+            return false;
+        SnapshotHeader header;
+        memcpy(header.magic, SNAPSHOT_MAGIC, sizeof(header.magic));
+        header.slotSize = (int)sizeof(Student);
+        header.size = (int)table.size();
+        file.write((char*)&header, sizeof(header));
+        file.write((char*)table.data(), sizeof(Student) * table.size());
+        return (bool)file;
     }
 
     // Display the hash table
     void display() {
         cout << "Index\tRollNo\tMarks\tLink\n";
-        for (int i = 0; i < SIZE; ++i) {
+        for (int i = 0; i < (int)table.size(); ++i) {
             if (table[i].occupied)
                 cout << i << "\t" << table[i].rollNo << "\t" << table[i].marks << "\t" << table[i].link << "\n";
+            else if (table[i].deleted)
+                cout << i << "\tDeleted\t\t" << table[i].link << "\n";
             else
                 cout << i << "\tEmpty\n";
         }
     }
 };
 
-int main() {
+// Read-only view of a saved table. The file is mapped into memory and the slots are used in
+// place, so opening costs the same for any table size; pages are read in as lookups touch them.
+class MappedHashTable {
+    void* data = MAP_FAILED;
+    size_t length = 0;
+    const Student* table = nullptr;
+    int size = 0;
+
+    int hashFunction(int rollNo) const {
+        return rollNo % size;
+    }
+
+public:
+    MappedHashTable(const char* path) {
+        int fd = open(path, O_RDONLY);
+        if (fd == -1)
+            return;
+        struct stat st;
+        if (fstat(fd, &st) == 0 && (size_t)st.st_size >= sizeof(SnapshotHeader)) {
+            length = (size_t)st.st_size;
+            data = mmap(nullptr, length, PROT_READ, MAP_SHARED, fd, 0);
+        }
+        close(fd);
+        if (data == MAP_FAILED)
+            return;
+
+        const SnapshotHeader* header = (const SnapshotHeader*)data;
+        if (memcmp(header->magic, SNAPSHOT_MAGIC, sizeof(header->magic)) != 0
+            || header->slotSize != (int)sizeof(Student) || header->size <= 0
+            || length < sizeof(SnapshotHeader) + sizeof(Student) * (size_t)header->size) {
+            cout << "Not a valid snapshot: " << path << "\n";
+            return;
+        }
+        size = header->size;
+        table = (const Student*)((const char*)data + sizeof(SnapshotHeader));
+    }
+
+    MappedHashTable(const MappedHashTable&) = delete;
+    MappedHashTable& operator=(const MappedHashTable&) = delete;
+
+    ~MappedHashTable() {
+        if (data != MAP_FAILED)
+            munmap(data, length);
+    }
+
+    bool isOpen() const { return table != nullptr; }
+
+    bool search(int rollNo, int& marks) const {
+        int j = hashFunction(rollNo);
+        if (!table[j].occupied && !table[j].deleted)
+            return false;
+
+        // Links come from the file, so each is checked before it is followed; a chain visits
+        // each slot at most once, so more steps than slots means a link cycle
+        for (int steps = 0; j != -1 && steps < size; ++steps) {
+            if (j < 0 || j >= size)
+                return false;
+            if (table[j].occupied && table[j].rollNo == rollNo) {
+                marks = table[j].marks;
+                return true;
+            }
+            j = table[j].link;
+        }
+        return false;
+    }
+};
+
+// Average lookup latency for stored (hit) and absent (miss) roll numbers at 80% load
+void benchmark(int size) {
+    int n = size * 8 / 10;
+    vector<int> keys(2 * n);
+    for (int i = 0; i < 2 * n; ++i)
+        keys[i] = 100000 + i;
+    shuffle(keys.begin(), keys.end(), mt19937(42));
+
+    HashTable ht(size);
+    for (int i = 0; i < n; ++i)
+        ht.insert(keys[i], i % 100);
+
+    int marks;
+    long long found = 0;
+    auto t0 = chrono::steady_clock::now();
+    for (int i = 0; i < n; ++i)
+        found += ht.search(keys[i], marks);
+    auto t1 = chrono::steady_clock::now();
+    for (int i = n; i < 2 * n; ++i)
+        found += ht.search(keys[i], marks);
+    auto t2 = chrono::steady_clock::now();
+
+    cout << "\nBenchmark (without replacement), size " << size << ", " << n << " records:\n";
+    cout << "Hit:  " << chrono::duration<double, nano>(t1 - t0).count() / n << " ns/lookup\n";
+    cout << "Miss: " << chrono::duration<double, nano>(t2 - t1).count() / n << " ns/lookup\n";
+    cout << "Found: " << found << "\n";
+}
+
+// Repeated insert versus build() for a nightly reload of n records
+void bulkBenchmark(int n) {
+    // Distinct random roll numbers, so some homes collide
+    mt19937 rng(7);
+    vector<int> keys;
+    while ((int)keys.size() < n) {
+        while ((int)keys.size() < n)
+            keys.push_back((int)(rng() >> 1));
+        sort(keys.begin(), keys.end());
+        keys.erase(unique(keys.begin(), keys.end()), keys.end());
+    }
+    shuffle(keys.begin(), keys.end(), rng);
+    vector<pair<int, int>> records(n);
+    for (int i = 0; i < n; ++i)
+        records[i] = {keys[i], i % 100};
+
+    auto t0 = chrono::steady_clock::now();
+    HashTable one((int)(n / 0.8) + 1);
+    for (const pair<int, int>& r : records)
+        one.insert(r.first, r.second);
+    auto t1 = chrono::steady_clock::now();
+    HashTable bulk;
+    bulk.build(records.begin(), records.end());
+    auto t2 = chrono::steady_clock::now();
+
+    int marks, missing = 0;
+    for (const pair<int, int>& r : records)
+        if (!bulk.search(r.first, marks) || marks != r.second)
+            ++missing;
+
+    double insertMs = chrono::duration<double, milli>(t1 - t0).count();
+    double buildMs = chrono::duration<double, milli>(t2 - t1).count();
+    cout << "\nBulk load of " << n << " records:\n";
+    cout << "Repeated insert: " << insertMs << " ms\n";
+    cout << "build():         " << buildMs << " ms (" << insertMs / buildMs << "x)\n";
+    cout << "Lookups failed after build: " << missing << "\n";
+}
+
+// Roll numbers that all share one home slot (like 31, 51, 71 in a table of 10) build a
+// single long chain. With the tail kept per home, time per insert stays flat as it grows.
+void chainStressBenchmark() {
+    cout << "\nSame-home inserts (chain length: ns/insert):\n";
+    for (int m = 1000; m <= 16000; m *= 2) {
+        int size = m * 2;
+        HashTable ht(size);
+        auto t0 = chrono::steady_clock::now();
+        for (int k = 0; k < m; ++k)
+            ht.insert(k * size + 1, k % 100);
+        auto t1 = chrono::steady_clock::now();
+        cout << m << ": " << chrono::duration<double, nano>(t1 - t0).count() / m << "\n";
+    }
+}
+
+// Save a table of n records, then time reopening it through the mapping
+void snapshotBenchmark(int n) {
+    vector<pair<int, int>> records(n);
+    for (int i = 0; i < n; ++i)
+        records[i] = {100000 + i * 7, i % 100};
+
+    HashTable ht((int)(n / 0.8) + 1);
+    for (const pair<int, int>& r : records)
+        ht.insert(r.first, r.second);
+    auto t0 = chrono::steady_clock::now();
+    ht.save(SNAPSHOT_FILE);
+    auto t1 = chrono::steady_clock::now();
+    MappedHashTable mapped(SNAPSHOT_FILE);
+    int marks, missing = mapped.isOpen() ? 0 : n;
+    bool first = mapped.isOpen() && mapped.search(records[0].first, marks);
+    auto t2 = chrono::steady_clock::now();
+    for (int i = 0; mapped.isOpen() && i < n; ++i)
+        if (!mapped.search(records[i].first, marks) || marks != records[i].second)
+            ++missing;
+    auto t3 = chrono::steady_clock::now();
+
+    cout << "\nSnapshot of " << n << " records:\n";
+    cout << "Save: " << chrono::duration<double, milli>(t1 - t0).count() << " ms\n";
+    cout << "Open + first lookup: " << chrono::duration<double, milli>(t2 - t1).count() << " ms"
+         << (first ? "" : " (lookup failed)") << "\n";
+    cout << "All lookups: " << chrono::duration<double, milli>(t3 - t2).count() << " ms, failed: " << missing << "\n";
+}
+
+int main(int argc, char* argv[]) {
     HashTable ht;
 
     int rollNos[] = {31, 13, 14, 51, 16, 71, 48, 19};
@@ -96,6 +545,32 @@ int main() {
     cout << "Final Hash Table (Linear Probing with Chaining Without Replacement):\n";
     ht.display();
 
+    int marks;
+    if (ht.search(71, marks))
+        cout << "\nRollNo 71 found with marks " << marks << "\n";
+    if (!ht.search(41, marks))
+        cout << "RollNo 41 not found\n";
+
+    ht.remove(51);
+    cout << "\nAfter deleting 51:\n";
+    ht.display();
+    if (ht.search(71, marks))
+        cout << "RollNo 71 still found with marks " << marks << "\n";
+
+    // Save the table and reopen it without rebuilding
+    if (ht.save(SNAPSHOT_FILE)) {
+        MappedHashTable mapped(SNAPSHOT_FILE);
+        if (mapped.isOpen() && mapped.search(71, marks))
+            cout << "RollNo 71 found in snapshot with marks " << marks << "\n";
+    }
+
+    if (argc > 1) {
+        benchmark(atoi(argv[1]));
+        bulkBenchmark(argc > 2 ? atoi(argv[2]) : 10000000);
+        chainStressBenchmark();
+        snapshotBenchmark(argc > 3 ? atoi(argv[3]) : 1000000);
+    }
+
     return 0;
 }
 
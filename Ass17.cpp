@@ -1,11 +1,18 @@
 // Department maintains student information. the file contains rollno, name, division, and address.
 // Allow user to add, edit, delete, insert and search information of student. use sequential file to
 // maintain the data
+// Records stay one CSV line each in file order. B+-tree indexes (StudentIndex.h) on roll
+// number, name (hashed) and division (sorted) hold the byte offset of each line, so search,
+// roll number ranges and lookups by name or division seek straight to their lines. Adding a
+// student appends to all three; they are rebuilt from the lines written whenever delete or
+// edit rewrites the file, and from a full read if they are missing or out of date.
 #include <iostream>
 #include <fstream>
 #include <string>
 #include <vector>
 #include <sstream>
+#include <sys/stat.h>
+#include "StudentIndex.h"
 
 using namespace std;
 
@@ -29,11 +36,117 @@ struct Student {
 };
 
 const string FILE_NAME = "students.txt";
+// Roll number, name and division indexes; each maps its key to the byte offset of the line
+const string INDEX_NAMES[3] = {FILE_NAME + ".idx", FILE_NAME + ".name.idx", FILE_NAME + ".div.idx"};
+
+// Version of the file an index matches: its size, inode and modification time mixed, so a
+// rewrite or an edit from outside changes it even when the size stays the same. Never 0,
+// which marks an index left open.
+uint64_t fileVersion() {
+    struct stat st;
+    if (stat(FILE_NAME.c_str(), &st) != 0)
+        return 1;
+    uint64_t parts[4] = {(uint64_t)st.st_size, (uint64_t)st.st_ino, (uint64_t)st.st_mtim.tv_sec,
+                         (uint64_t)st.st_mtim.tv_nsec};
+    uint64_t version = 14695981039346656037ULL;
+    for (uint64_t part : parts) {
+        version = (version ^ part) * 1099511628211ULL;
+        version ^= version >> 29;
+    }
+    return version == 0 ? 1 : version;
+}
+
+// Where the next appended line starts
+int64_t fileSize() {
+    struct stat st;
+    return stat(FILE_NAME.c_str(), &st) == 0 ? (int64_t)st.st_size : 0;
+}
+
+// Index entries collected while reading or writing the whole file
+struct IndexEntries {
+    vector<pair<int32_t, int64_t>> byRoll;
+    vector<pair<NameKey, int64_t>> byName;
+    vector<pair<DivisionKey, int64_t>> byDivision;
+
+    void add(const Student& s, int64_t offset) {
+        byRoll.push_back({s.rollNo, offset});
+        byName.push_back({nameKey(s.name, s.rollNo), offset});
+        byDivision.push_back({divisionKey(s.division, s.rollNo), offset});
+    }
+};
+
+struct Indexes {
+    RollIndex rolls;
+    NameIndex names;
+    DivisionIndex divisions;
+
+    bool open() {
+        return rolls.open(INDEX_NAMES[0], fileVersion()) && names.open(INDEX_NAMES[1], fileVersion())
+            && divisions.open(INDEX_NAMES[2], fileVersion());
+    }
+
+    bool create(const IndexEntries& entries) {
+        return rolls.create(INDEX_NAMES[0], entries.byRoll, fileVersion())
+            && names.create(INDEX_NAMES[1], entries.byName, fileVersion())
+            && divisions.create(INDEX_NAMES[2], entries.byDivision, fileVersion());
+    }
+
+    void add(const Student& s, int64_t offset) {
+        rolls.insert(s.rollNo, offset);
+        names.insert(nameKey(s.name, s.rollNo), offset);
+        divisions.insert(divisionKey(s.division, s.rollNo), offset);
+    }
+
+    // Stamps the indexes as matching the file as it is now
+    void close() {
+        uint64_t version = fileVersion();
+        rolls.setStamp(version);
+        names.setStamp(version);
+        divisions.setStamp(version);
+        rolls.close();
+        names.close();
+        divisions.close();
+    }
+
+    ~Indexes() { close(); }
+};
+
+// Opens the indexes, rebuilding all three if the file changed without them
+bool openIndexes(Indexes& indexes) {
+    if (indexes.open())
+        return true;
+    IndexEntries entries;
+    ifstream file(FILE_NAME);
+    string line;
+    for (int64_t offset = 0; getline(file, line); offset = file.tellg())
+        entries.add(Student::from_string(line), offset);
+    file.close();
+    return indexes.create(entries);
+}
+
+Student readAt(ifstream& file, int64_t offset) {
+    string line;
+    file.seekg(offset);
+    getline(file, line);
+    return Student::from_string(line);
+}
 
 void addStudent(const Student& s) {
+    Indexes indexes;
+    int64_t offset;
+    if (!openIndexes(indexes)) {
+        cout << "Cannot open the indexes of " << FILE_NAME << endl;
+        return;
+    }
+    if (indexes.rolls.find(s.rollNo, offset)) {
+        cout << "Roll No " << s.rollNo << " already exists!\n";
+        return;
+    }
+    offset = fileSize();
     ofstream file(FILE_NAME, ios::app);
     file << s.to_string() << endl;
     file.close();
+    indexes.add(s, offset);
 }
 
 void displayAll() {
@@ -48,71 +161,136 @@ void displayAll() {
 }
 
 void searchStudent(int roll) {
+    Indexes indexes;
+    int64_t offset;
+    if (!openIndexes(indexes) || !indexes.rolls.find(roll, offset)) {
+        cout << "Record not found!\n";
+        return;
+    }
     ifstream file(FILE_NAME);
-    string line;
-    bool found = false;
-    while (getline(file, line)) {
-        Student s = Student::from_string(line);
-        if (s.rollNo == roll) {
-            cout << "\nRecord Found:\n";
-            cout << "RollNo: " << s.rollNo << "\nName: " << s.name
-                 << "\nDivision: " << s.division << "\nAddress: " << s.address << endl;
-            found = true;
-            break;
-        }
+    Student s = readAt(file, offset);
+    cout << "\nRecord Found:\n";
+    cout << "RollNo: " << s.rollNo << "\nName: " << s.name
+         << "\nDivision: " << s.division << "\nAddress: " << s.address << endl;
+    file.close();
+}
+
+// Offsets of the lines of students with this name. The name index gives the lines whose
+// names share the hash; each is read to drop other names.
+vector<int64_t> findByName(const string& name) {
+    Indexes indexes;
+    vector<int64_t> found;
+    if (!openIndexes(indexes))
+        return found;
+    ifstream file(FILE_NAME);
+    uint32_t hash = nameHash(name);
+    indexes.names.range(NameKey{hash, INT32_MIN}, NameKey{hash, INT32_MAX}, [&](const NameKey&, int64_t offset) {
+        if (readAt(file, offset).name == name)
+            found.push_back(offset);
+    });
+    return found;
+}
+
+// Offsets of the lines of a division, in roll number order. Divisions longer than the
+// index key are checked against the line.
+vector<int64_t> findByDivision(const string& division) {
+    Indexes indexes;
+    vector<int64_t> found;
+    if (!openIndexes(indexes))
+        return found;
+    ifstream file(FILE_NAME);
+    bool check = division.size() >= sizeof(DivisionKey::division);
+    indexes.divisions.range(divisionKey(division, INT32_MIN), divisionKey(division, INT32_MAX),
+                            [&](const DivisionKey&, int64_t offset) {
+        if (!check || readAt(file, offset).division == division)
+            found.push_back(offset);
+    });
+    return found;
+}
+
+// Prints the lines at the given offsets
+void displayAt(const vector<int64_t>& offsets) {
+    ifstream file(FILE_NAME);
+    cout << "\nRollNo\tName\tDivision\tAddress" << endl;
+    for (int64_t offset : offsets) {
+        Student s = readAt(file, offset);
+        cout << s.rollNo << "\t" << s.name << "\t" << s.division << "\t\t" << s.address << endl;
     }
-    if (!found) cout << "Record not found!\n";
     file.close();
 }
 
-void deleteStudent(int roll) {
+// Lists the students with roll numbers from low to high, in roll number order
+void listRange(int low, int high) {
+    Indexes indexes;
+    vector<int64_t> offsets;
+    if (!openIndexes(indexes)) {
+        cout << "Cannot open the indexes of " << FILE_NAME << endl;
+        return;
+    }
+    indexes.rolls.range(low, high, [&](int, int64_t offset) { offsets.push_back(offset); });
+    displayAt(offsets);
+}
+
+// Rewrites the file without roll's line, or with newDetails in its place, and indexes the
+// lines as they are written
+void rewriteFile(int roll, const Student* newDetails) {
     ifstream file(FILE_NAME);
     ofstream temp("temp.txt");
     string line;
-    bool deleted = false;
+    IndexEntries entries;
     while (getline(file, line)) {
         Student s = Student::from_string(line);
         if (s.rollNo == roll) {
-            deleted = true;
-            continue;
+            if (newDetails == nullptr)
+                continue;
+            s = *newDetails;
+            line = s.to_string();
         }
+        entries.add(s, (int64_t)temp.tellp());
         temp << line << endl;
     }
     file.close();
     temp.close();
+    // The old indexes go first, so a crash before they are recreated leaves none to trust
+    for (const string& name : INDEX_NAMES)
+        remove(name.c_str());
     remove(FILE_NAME.c_str());
     rename("temp.txt", FILE_NAME.c_str());
-    if (deleted) cout << "Record deleted successfully.\n";
-    else cout << "Record not found!\n";
+    Indexes indexes;
+    indexes.create(entries);
+}
+
+void deleteStudent(int roll) {
+    {
+        Indexes indexes;
+        int64_t offset;
+        if (!openIndexes(indexes) || !indexes.rolls.find(roll, offset)) {
+            cout << "Record not found!\n";
+            return;
+        }
+    }
+    rewriteFile(roll, nullptr);
+    cout << "Record deleted successfully.\n";
 }
 
 void editStudent(int roll, const Student& newDetails) {
-    ifstream file(FILE_NAME);
-    ofstream temp("temp.txt");
-    string line;
-    bool edited = false;
-    while (getline(file, line)) {
-        Student s = Student::from_string(line);
-        if (s.rollNo == roll) {
-            temp << newDetails.to_string() << endl;
-            edited = true;
-        } else {
-            temp << line << endl;
+    {
+        Indexes indexes;
+        int64_t offset;
+        if (!openIndexes(indexes) || !indexes.rolls.find(roll, offset)) {
+            cout << "Record not found!\n";
+            return;
         }
     }
-    file.close();
-    temp.close();
-    remove(FILE_NAME.c_str());
-    rename("temp.txt", FILE_NAME.c_str());
-    if (edited) cout << "Record updated successfully.\n";
-    else cout << "Record not found!\n";
+    rewriteFile(roll, &newDetails);
+    cout << "Record updated successfully.\n";
 }
 
 int main() {
     int choice;
     do {
         cout << "\n--- Student Record Manager ---\n";
-        cout << "1. Add Student\n2. Display All\n3. Search by RollNo\n4. Delete Record\n5. Edit Record\n6. Exit\nEnter choice: ";
+        cout << "1. Add Student\n2. Display All\n3. Search by RollNo\n4. Delete Record\n5. Edit Record\n6. List RollNo Range\n7. Search by Name\n8. List Division\n9. Exit\nEnter choice: ";
         cin >> choice;
 
         if (choice == 1) {
@@ -138,11 +316,24 @@ int main() {
             cout << "New Address: "; getline(cin, s.address);
             editStudent(s.rollNo, s);
         } else if (choice == 6) {
+            int low, high; cout << "Enter lowest and highest RollNo: "; cin >> low >> high;
+            listRange(low, high);
+        } else if (choice == 7) {
+            string name; cout << "Enter Name to search: "; cin.ignore(); getline(cin, name);
+            vector<int64_t> found = findByName(name);
+            if (found.empty()) cout << "Record not found!\n";
+            else displayAt(found);
+        } else if (choice == 8) {
+            string division; cout << "Enter Division: "; cin.ignore(); getline(cin, division);
+            vector<int64_t> found = findByDivision(division);
+            displayAt(found);
+            cout << found.size() << " students in division " << division << ".\n";
+        } else if (choice == 9) {
             cout << "Exiting...\n";
         } else {
             cout << "Invalid choice!\n";
         }
-    } while (choice != 6);
+    } while (choice != 9);
 
     return 0;
 }
@@ -0,0 +1,524 @@
+// Consider the student database of N students and their marks. Make use of a hash table
+// implementation to quickly insert and lookup students' Rollno and marks. Implement collision
+// handling techniques- linear probing with chaining without replacement.
+// Growable version: the table doubles once the load factor crosses a configurable limit and the
+// old slots are moved over a few at a time on every operation (incremental rehash), so no single
+// insert pays for copying the whole table.
+// Slots can be stored as an array of Student structs (AosStorage) or as separate arrays of
+// roll numbers, links and marks plus an occupancy bitmap (SoaStorage), so probes only touch
+// the key and link arrays.
+// The hash function is a policy parameter (ModuloHash, FibonacciHash, MurmurHash,
+// TabulationHash) and capacities are powers of two, so a slot index is a shift or a mask
+// rather than a modulo.
+// Usage: ./a.out              the test case above
+//        ./a.out students     also the AoS/SoA growth and hash function benchmarks for that
+//                             many students (500000 is a full term)
+
+#include <iostream>
+#include <vector>
+#include <chrono>
+#include <cstdlib>
+#include <random>
+#include <algorithm>
+#include <cstdint>
+#ifdef __linux__
+#include <linux/perf_event.h>
+#include <sys/ioctl.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#endif
+using namespace std;
+
+const int SIZE = 10;
+
+struct Student {
+    int rollNo;
+    int marks;
+    int link;
+    bool occupied;
+
+    Student() {
+        rollNo = -1;
+        marks = 0;
+        link = -1;
+        occupied = false;
+    }
+};
+
+// Array of structures: one Student per slot
+class AosStorage {
+    vector<Student> slots;
+
+public:
+    void assign(size_t n) { slots.assign(n, Student()); }
+    void release() { vector<Student>().swap(slots); }
+    void swap(AosStorage& other) { slots.swap(other.slots); }
+    size_t size() const { return slots.size(); }
+    bool empty() const { return slots.empty(); }
+
+    bool occupied(size_t i) const { return slots[i].occupied; }
+    int rollNo(size_t i) const { return slots[i].rollNo; }
+    int marks(size_t i) const { return slots[i].marks; }
+    int link(size_t i) const { return slots[i].link; }
+    void setLink(size_t i, int link) { slots[i].link = link; }
+
+    void set(size_t i, int rollNo, int marks) {
+        slots[i].rollNo = rollNo;
+        slots[i].marks = marks;
+        slots[i].occupied = true;
+    }
+};
+
+// Structure of arrays: keys, links and marks in separate arrays, occupancy as a bitmap
+class SoaStorage {
+    vector<int> rollNos;
+    vector<int> links;
+    vector<int> marksList;
+    vector<uint64_t> occupiedBits;
+
+public:
+    void assign(size_t n) {
+        rollNos.assign(n, -1);
+        links.assign(n, -1);
+        marksList.assign(n, 0);
+        occupiedBits.assign((n + 63) / 64, 0);
+    }
+
+    void release() {
+        vector<int>().swap(rollNos);
+        vector<int>().swap(links);
+        vector<int>().swap(marksList);
+        vector<uint64_t>().swap(occupiedBits);
+    }
+
+    void swap(SoaStorage& other) {
+        rollNos.swap(other.rollNos);
+        links.swap(other.links);
+        marksList.swap(other.marksList);
+        occupiedBits.swap(other.occupiedBits);
+    }
+
+    size_t size() const { return rollNos.size(); }
+    bool empty() const { return rollNos.empty(); }
+
+    bool occupied(size_t i) const { return (occupiedBits[i / 64] >> (i % 64)) & 1; }
+    int rollNo(size_t i) const { return rollNos[i]; }
+    int marks(size_t i) const { return marksList[i]; }
+    int link(size_t i) const { return links[i]; }
+    void setLink(size_t i, int link) { links[i] = link; }
+
+    void set(size_t i, int rollNo, int marks) {
+        rollNos[i] = rollNo;
+        marksList[i] = marks;
+        occupiedBits[i / 64] |= 1ULL << (i % 64);
+    }
+};
+
+// Hash policies map a roll number to a slot in a table of 2^bits slots (bits >= 1)
+
+// rollNo % capacity as in Ass1.cpp; with a power-of-two capacity this keeps the low bits
+struct ModuloHash {
+    size_t operator()(int rollNo, int bits) const {
+        return (uint32_t)rollNo & ((1ULL << bits) - 1);
+    }
+};
+
+// Fibonacci multiplicative hashing: multiply by 2^64 / golden ratio, keep the top bits
+struct FibonacciHash {
+    size_t operator()(int rollNo, int bits) const {
+        return (size_t)(((uint64_t)(uint32_t)rollNo * 11400714819323198485ULL) >> (64 - bits));
+    }
+};
+
+// murmur3 fmix64 finalizer: every input bit affects every output bit
+struct MurmurHash {
+    size_t operator()(int rollNo, int bits) const {
+        uint64_t h = (uint32_t)rollNo;
+        h ^= h >> 33;
+        h *= 0xff51afd7ed558ccdULL;
+        h ^= h >> 33;
+        h *= 0xc4ceb9fe1a85ec53ULL;
+        h ^= h >> 33;
+        return (size_t)(h >> (64 - bits));
+    }
+};
+
+// Tabulation hashing: XOR of random table entries, one table per byte of the key
+class TabulationHash {
+    uint64_t tables[4][256];
+
+public:
+    TabulationHash(uint64_t seed = 42) {
+        mt19937_64 rng(seed);
+        for (auto& t : tables)
+            for (uint64_t& v : t)
+                v = rng();
+    }
+
+    size_t operator()(int rollNo, int bits) const {
+        uint32_t x = (uint32_t)rollNo;
+        uint64_t h = tables[0][x & 0xFF] ^ tables[1][(x >> 8) & 0xFF]
+                   ^ tables[2][(x >> 16) & 0xFF] ^ tables[3][x >> 24];
+        return (size_t)(h >> (64 - bits));
+    }
+};
+
+template <class Storage, class Hash = ModuloHash>
+class GrowableHashTable {
+    Storage table;              // table receiving all new inserts
+    Storage oldTable;           // table being drained while a rehash is in progress
+    size_t tableCount = 0;      // records stored in table
+    size_t oldCount = 0;        // records in oldTable not yet moved
+    size_t migrateIndex = 0;    // next oldTable slot to move
+    double maxLoadFactor;
+    size_t migrateStep;         // oldTable slots moved per operation
+    Hash hasher;
+
+    // Statistics
+    size_t inserts = 0;
+    size_t collisions = 0;      // inserts whose home slot was taken
+    size_t insertProbes = 0;    // slots looked at to find a free slot
+    size_t maxInsertProbe = 0;
+    size_t chainSteps = 0;      // links followed to reach a chain tail
+    size_t maxChainSteps = 0;
+    size_t resizes = 0;
+    size_t slotsMigrated = 0;
+
+    // capacity is always a power of two
+    size_t hashFunction(int rollNo, size_t capacity) const {
+        return hasher(rollNo, __builtin_ctzll(capacity));
+    }
+
+    // Linear probing with chaining without replacement, exactly as in Ass1.cpp
+    void place(Storage& t, int rollNo, int marks) {
+        size_t capacity = t.size();
+        size_t index = hashFunction(rollNo, capacity);
+        size_t probes = 1;
+
+        // Case 1: Home slot is empty
+        if (!t.occupied(index)) {
+            t.set(index, rollNo, marks);
+            recordInsert(probes, 0);
+            return;
+        }
+
+        // Case 2: Home slot is occupied — find next free slot
+        size_t i = (index + 1) & (capacity - 1);
+        while (t.occupied(i)) {
+            i = (i + 1) & (capacity - 1);
+            ++probes;
+        }
+
+        t.set(i, rollNo, marks);
+
+        // Chain from home slot (without replacement)
+        size_t j = index;
+        size_t steps = 0;
+        while (t.link(j) != -1) {
+            j = (size_t)t.link(j);
+            ++steps;
+        }
+        t.setLink(j, (int)i);
+        recordInsert(probes, steps);
+    }
+
+    void recordInsert(size_t probes, size_t steps) {
+        ++inserts;
+        if (probes > 1) ++collisions;
+        insertProbes += probes;
+        chainSteps += steps;
+        if (probes > maxInsertProbe) maxInsertProbe = probes;
+        if (steps > maxChainSteps) maxChainSteps = steps;
+    }
+
+    bool searchIn(const Storage& t, int rollNo, int& marks) const {
+        if (t.empty()) return false;
+        int j = (int)hashFunction(rollNo, t.size());
+        if (!t.occupied(j)) return false;
+        while (j != -1) {
+            if (t.rollNo(j) == rollNo) {
+                marks = t.marks(j);
+                return true;
+            }
+            j = t.link(j);
+        }
+        return false;
+    }
+
+    // Move up to migrateStep slots from oldTable into table
+    void migrate() {
+        size_t moved = 0;
+        while (moved < migrateStep && migrateIndex < oldTable.size()) {
+            size_t i = migrateIndex++;
+            if (oldTable.occupied(i)) {
+                place(table, oldTable.rollNo(i), oldTable.marks(i));
+                ++tableCount;
+                --oldCount;
+                ++slotsMigrated;
+            }
+            ++moved;
+        }
+        if (migrateIndex == oldTable.size()) {
+            // Old chains are only walked by lookups, so the table is kept intact until drained
+            oldTable.release();
+            migrateIndex = 0;
+        }
+    }
+
+    void startResize() {
+        // Finish any pending rehash before starting another one
+        while (rehashing())
+            migrate();
+
+        oldTable.swap(table);
+        oldCount = tableCount;
+        tableCount = 0;
+        migrateIndex = 0;
+        table.assign(oldTable.size() * 2);
+        ++resizes;
+    }
+
+public:
+    GrowableHashTable(size_t initialCapacity = SIZE, double loadFactor = 0.7, size_t step = 4)
+        : maxLoadFactor(loadFactor), migrateStep(step < 1 ? 1 : step) {
+        size_t capacity = 2;
+        while (capacity < initialCapacity)
+            capacity *= 2;
+        table.assign(capacity);
+    }
+
+    // Insert a roll number and marks into the hash table
+    void insert(int rollNo, int marks) {
+        if (rehashing())
+            migrate();
+        if ((double)(tableCount + 1) / table.size() > maxLoadFactor)
+            startResize();
+
+        place(table, rollNo, marks);
+        ++tableCount;
+    }
+
+    // Look up marks for a roll number; returns false if it is not stored
+    bool search(int rollNo, int& marks) {
+        if (rehashing())
+            migrate();
+        if (searchIn(table, rollNo, marks))
+            return true;
+        return oldCount > 0 && searchIn(oldTable, rollNo, marks);
+    }
+
+    bool rehashing() const { return !oldTable.empty(); }
+    size_t size() const { return tableCount + oldCount; }
+    size_t capacity() const { return table.size(); }
+    double loadFactor() const { return (double)tableCount / table.size(); }
+    double collisionRate() const { return inserts ? (double)collisions / inserts : 0; }
+    double meanProbe() const { return inserts ? (double)insertProbes / inserts : 0; }
+    size_t maxProbe() const { return maxInsertProbe; }
+
+    void printStats() const {
+        cout << "Records: " << size() << ", Capacity: " << capacity()
+             << ", Load factor: " << loadFactor()
+             << (rehashing() ? " (rehash in progress)" : "") << "\n";
+        cout << "Resizes: " << resizes << ", Slots migrated: " << slotsMigrated << "\n";
+        if (inserts > 0) {
+            cout << "Collision rate: " << collisionRate() << "\n";
+            cout << "Avg probe length: " << (double)insertProbes / inserts
+                 << ", Max probe length: " << maxInsertProbe << "\n";
+            cout << "Avg chain walk: " << (double)chainSteps / inserts
+                 << ", Max chain walk: " << maxChainSteps << "\n";
+        }
+    }
+
+    // Display the hash table (any pending rehash is finished first)
+    void display() {
+        while (rehashing())
+            migrate();
+        cout << "Index\tRollNo\tMarks\tLink\n";
+        for (size_t i = 0; i < table.size(); ++i) {
+            if (table.occupied(i))
+                cout << i << "\t" << table.rollNo(i) << "\t" << table.marks(i) << "\t" << table.link(i) << "\n";
+            else
+                cout << i << "\tEmpty\n";
+        }
+    }
+};
+
+// Counts last-level cache misses around a block of code (Linux perf events)
+class CacheMissCounter {
+    int fd = -1;
+
+public:
+    CacheMissCounter() {
+#ifdef __linux__
+        perf_event_attr attr = {};
+        attr.type = PERF_TYPE_HARDWARE;
+        attr.size = sizeof(attr);
+        attr.config = PERF_COUNT_HW_CACHE_MISSES;
+        attr.disabled = 1;
+        attr.exclude_kernel = 1;
+        attr.exclude_hv = 1;
+        fd = (int)syscall(SYS_perf_event_open, &attr, 0, -1, -1, 0);
+#endif
+    }
+
+    ~CacheMissCounter() {
+#ifdef __linux__
+        if (fd != -1) close(fd);
+#endif
+    }
+
+    bool available() const { return fd != -1; }
+
+    void start() {
+#ifdef __linux__
+        if (fd == -1) return;
+        ioctl(fd, PERF_EVENT_IOC_RESET, 0);
+        ioctl(fd, PERF_EVENT_IOC_ENABLE, 0);
+#endif
+    }
+
+    long long stop() {
+        long long misses = 0;
+#ifdef __linux__
+        if (fd == -1) return -1;
+        ioctl(fd, PERF_EVENT_IOC_DISABLE, 0);
+        if (read(fd, &misses, sizeof(misses)) != sizeof(misses))
+            return -1;
+#endif
+        return misses;
+    }
+};
+
+// Time and cache misses per lookup for one storage layout
+template <class Storage>
+void benchmark(const char* name, const vector<int>& keys, int students) {
+    GrowableHashTable<Storage> ht;
+    auto start = chrono::steady_clock::now();
+    for (int i = 0; i < students; ++i)
+        ht.insert(keys[i], i % 100);
+    auto end = chrono::steady_clock::now();
+
+    CacheMissCounter counter;
+    int missing = 0, marks;
+    counter.start();
+    auto hitStart = chrono::steady_clock::now();
+    for (int i = 0; i < students; ++i)
+        if (!ht.search(keys[i], marks) || marks != i % 100)
+            ++missing;
+    auto hitEnd = chrono::steady_clock::now();
+    long long hitMisses = counter.stop();
+
+    // Roll numbers that were never inserted only touch the probe path
+    counter.start();
+    for (int i = students; i < 2 * students; ++i)
+        if (ht.search(keys[i], marks))
+            ++missing;
+    auto missEnd = chrono::steady_clock::now();
+    long long missMisses = counter.stop();
+
+    cout << "\n" << name << ": inserted " << students << " students in "
+         << chrono::duration<double, milli>(end - start).count() << " ms\n";
+    ht.printStats();
+    cout << "Hit:  " << chrono::duration<double, nano>(hitEnd - hitStart).count() / students << " ns/lookup";
+    if (hitMisses >= 0)
+        cout << ", " << (double)hitMisses / students << " cache misses/lookup";
+    cout << "\nMiss: " << chrono::duration<double, nano>(missEnd - hitEnd).count() / students << " ns/lookup";
+    if (missMisses >= 0)
+        cout << ", " << (double)missMisses / students << " cache misses/lookup";
+    cout << "\nWrong results: " << missing << "\n";
+    if (!counter.available())
+        cout << "(cache misses not shown: perf events unavailable)\n";
+}
+
+// Collision rate, probe length and throughput of one hash policy on one key set
+template <class Hash>
+void hashBenchmark(const char* name, const vector<int>& keys) {
+    GrowableHashTable<AosStorage, Hash> ht;
+    int n = (int)keys.size();
+    auto t0 = chrono::steady_clock::now();
+    for (int i = 0; i < n; ++i)
+        ht.insert(keys[i], i % 100);
+    auto t1 = chrono::steady_clock::now();
+    int marks, found = 0;
+    for (int i = 0; i < n; ++i)
+        found += ht.search(keys[i], marks);
+    auto t2 = chrono::steady_clock::now();
+
+    cout << name << "\t" << ht.collisionRate() << "\t" << ht.meanProbe() << "/" << ht.maxProbe()
+         << "\t" << n / chrono::duration<double, micro>(t1 - t0).count()
+         << "\t" << n / chrono::duration<double, micro>(t2 - t1).count()
+         << (found == n ? "" : "\tLOOKUPS FAILED") << "\n";
+}
+
+void hashReport(const char* distribution, const vector<int>& keys) {
+    cout << "\n" << distribution << " (" << keys.size() << " keys)\n";
+    cout << "Hash\t\tColl.\tProbe avg/max\tInsert M/s\tLookup M/s\n";
+    hashBenchmark<ModuloHash>("Modulo\t", keys);
+    hashBenchmark<FibonacciHash>("Fibonacci", keys);
+    hashBenchmark<MurmurHash>("Murmur\t", keys);
+    hashBenchmark<TabulationHash>("Tabulation", keys);
+}
+
+int main(int argc, char* argv[]) {
+    GrowableHashTable<AosStorage> ht;
+
+    int rollNos[] = {31, 13, 14, 51, 16, 71, 48, 19};
+    int n = sizeof(rollNos) / sizeof(rollNos[0]);
+
+    for (int i = 0; i < n; ++i) {
+        ht.insert(rollNos[i], rollNos[i] + 50);
+    }
+
+    cout << "Final Hash Table (Growable, Linear Probing with Chaining Without Replacement):\n";
+    ht.display();
+    ht.printStats();
+
+    if (argc > 1) {
+        // Load a full term of students to see what growth costs
+        int students = atoi(argv[1]);
+        vector<int> keys(students * 3);
+        for (size_t i = 0; i < keys.size(); ++i)
+            keys[i] = 100000 + (int)i;
+        shuffle(keys.begin(), keys.end(), mt19937(42));
+
+        benchmark<AosStorage>("AoS", keys, students);
+        benchmark<SoaStorage>("SoA", keys, students);
+
+        // Roll numbers as the university issues them
+        vector<int> sequential(students);
+        for (int i = 0; i < students; ++i)
+            sequential[i] = 100000 + i;
+        hashReport("Sequential roll numbers", sequential);
+
+        // YYYY BB SSS: admission year, branch code, serial within the branch
+        vector<int> structured;
+        for (int year = 2016; (int)structured.size() < students; ++year)
+            for (int branch = 1; branch <= 40 && (int)structured.size() < students; ++branch)
+                for (int serial = 1; serial <= 700 && (int)structured.size() < students; ++serial)
+                    structured.push_back(year * 100000 + branch * 1000 + serial);
+        hashReport("Year/branch/serial roll numbers", structured);
+
+        // Shared suffix, like 31, 51, 71: one division's numbers end in the same digit
+        vector<int> suffix(students);
+        for (int i = 0; i < students; ++i)
+            suffix[i] = 11 + i * 20;
+        hashReport("Shared-suffix roll numbers", suffix);
+    }
+
+    return 0;
+}
+
+// Sample output (test case):
+// Index   RollNo  Marks   Link
+// 0       16      66      1
+// 1       48      98      -1
+// 2       Empty
+// 3       51      101     4
+// 4       19      69      -1
+// ...
+// 7       71      121     -1
+// ...
+// 13      13      63      -1
+// 14      14      64      -1
+// 15      31      81      -1
+// Records: 8, Capacity: 16, Load factor: 0.5
@@ -0,0 +1,348 @@
+// Consider the student database of N students and their marks. Make use of a hash table
+// implementation to quickly insert and lookup students' Rollno and marks.
+// Robin Hood hashing: on every probe the incoming record takes the slot of any record that is
+// closer to its own home, so probe distances stay balanced. Deletion shifts the following
+// records back by one instead of leaving tombstones. The benchmark compares probe lengths with
+// the two chaining strategies from Ass1.cpp (without replacement) and Ass21.cpp (with replacement).
+
+#include <iostream>
+#include <vector>
+#include <string>
+#include <chrono>
+#include <random>
+#include <algorithm>
+#include <cstdlib>
+using namespace std;
+
+const int SIZE = 10;
+
+struct Student {
+    int rollNo;
+    int marks;
+    int link;   // chaining strategies only
+    int dist;   // Robin Hood only: distance from home slot, -1 when empty
+
+    Student() {
+        rollNo = -1;
+        marks = 0;
+        link = -1;
+        dist = -1;
+    }
+
+    bool occupied() const { return dist != -1; }
+};
+
+class RobinHoodHashTable {
+    vector<Student> table;
+    int count = 0;
+
+    int hashFunction(int rollNo) {
+        return rollNo % (int)table.size();
+    }
+
+public:
+    RobinHoodHashTable(int size = SIZE) : table(size) {}
+
+    // Returns the number of slots probed, or -1 if the table is full
+    int insert(int rollNo, int marks) {
+        if (count == (int)table.size()) {
+            cout << "Hash table is full!\n";
+            return -1;
+        }
+
+        int size = (int)table.size();
+        Student s;
+        s.rollNo = rollNo;
+        s.marks = marks;
+        s.dist = 0;
+
+        int i = hashFunction(rollNo);
+        int probes = 1;
+        while (table[i].occupied()) {
+            // Take the slot from a record that is closer to its home than we are
+            if (table[i].dist < s.dist)
+                swap(table[i], s);
+            i = (i + 1) % size;
+            ++s.dist;
+            ++probes;
+        }
+        table[i] = s;
+        ++count;
+        return probes;
+    }
+
+    // Returns the number of slots probed; marks is set on a hit
+    int search(int rollNo, int& marks, bool& found) {
+        int size = (int)table.size();
+        int i = hashFunction(rollNo);
+        int d = 0;
+        found = false;
+
+        // A record further than its own distance cannot be ours
+        while (table[i].occupied() && table[i].dist >= d) {
+            if (table[i].rollNo == rollNo) {
+                marks = table[i].marks;
+                found = true;
+                return d + 1;
+            }
+            i = (i + 1) % size;
+            ++d;
+        }
+        return d + 1;
+    }
+
+    // Backward-shift deletion: pull the following records one slot closer to home
+    bool remove(int rollNo) {
+        int size = (int)table.size();
+        int i = hashFunction(rollNo);
+        int d = 0;
+        while (table[i].occupied() && table[i].dist >= d) {
+            if (table[i].rollNo == rollNo) {
+                int next = (i + 1) % size;
+                while (table[next].occupied() && table[next].dist > 0) {
+                    table[i] = table[next];
+                    --table[i].dist;
+                    i = next;
+                    next = (next + 1) % size;
+                }
+                table[i] = Student();
+                --count;
+                return true;
+            }
+            i = (i + 1) % size;
+            ++d;
+        }
+        return false;
+    }
+
+    void display() {
+        cout << "Index\tRollNo\tMarks\tDist\n";
+        for (int i = 0; i < (int)table.size(); ++i) {
+            if (table[i].occupied())
+                cout << i << "\t" << table[i].rollNo << "\t" << table[i].marks << "\t" << table[i].dist << "\n";
+            else
+                cout << i << "\tEmpty\n";
+        }
+    }
+};
+
+// Linear probing with chaining without replacement (Ass1.cpp), instrumented with probe counts
+class WithoutReplacementHashTable {
+    vector<Student> table;
+
+    int hashFunction(int rollNo) {
+        return rollNo % (int)table.size();
+    }
+
+public:
+    WithoutReplacementHashTable(int size = SIZE) : table(size) {}
+
+    int insert(int rollNo, int marks) {
+        int size = (int)table.size();
+        int index = hashFunction(rollNo);
+        int probes = 1;
+
+        int i = index;
+        while (table[i].occupied()) {
+            i = (i + 1) % size;
+            ++probes;
+            if (i == index) {
+                cout << "Hash table is full!\n";
+                return -1;
+            }
+        }
+        table[i].rollNo = rollNo;
+        table[i].marks = marks;
+        table[i].dist = 0;
+
+        if (i != index) {
+            int j = index;
+            while (table[j].link != -1) {
+                j = table[j].link;
+                ++probes;
+            }
+            table[j].link = i;
+        }
+        return probes;
+    }
+
+    int search(int rollNo, int& marks, bool& found) {
+        int j = hashFunction(rollNo);
+        int probes = 1;
+        found = false;
+        if (!table[j].occupied())
+            return probes;
+        while (true) {
+            if (table[j].rollNo == rollNo) {
+                marks = table[j].marks;
+                found = true;
+                return probes;
+            }
+            if (table[j].link == -1)
+                return probes;
+            j = table[j].link;
+            ++probes;
+        }
+    }
+};
+
+// Linear probing with chaining with replacement (Ass21.cpp), instrumented with probe counts
+class WithReplacementHashTable {
+    vector<Student> table;
+
+    int hashFunction(int rollNo) {
+        return rollNo % (int)table.size();
+    }
+
+public:
+    WithReplacementHashTable(int size = SIZE) : table(size) {}
+
+    int insert(int rollNo, int marks) {
+        int size = (int)table.size();
+        int home = hashFunction(rollNo);
+        int probes = 1;
+
+        if (!table[home].occupied()) {
+            table[home].rollNo = rollNo;
+            table[home].marks = marks;
+            table[home].dist = 0;
+            table[home].link = -1;
+            return probes;
+        }
+
+        int i = (home + 1) % size;
+        while (table[i].occupied()) {
+            i = (i + 1) % size;
+            ++probes;
+            if (i == home) {
+                cout << "Hash table is full!\n";
+                return -1;
+            }
+        }
+
+        int existingHome = hashFunction(table[home].rollNo);
+        if (existingHome != home) {
+            int prev = existingHome;
+            while (table[prev].link != home) {
+                prev = table[prev].link;
+                ++probes;
+            }
+            table[i] = table[home];
+            table[prev].link = i;
+            table[home].rollNo = rollNo;
+            table[home].marks = marks;
+            table[home].link = -1;
+        } else {
+            table[i].rollNo = rollNo;
+            table[i].marks = marks;
+            table[i].dist = 0;
+            table[i].link = -1;
+            int j = home;
+            while (table[j].link != -1) {
+                j = table[j].link;
+                ++probes;
+            }
+            table[j].link = i;
+        }
+        return probes;
+    }
+
+    int search(int rollNo, int& marks, bool& found) {
+        int j = hashFunction(rollNo);
+        int probes = 1;
+        found = false;
+        if (!table[j].occupied() || hashFunction(table[j].rollNo) != j)
+            return probes;
+        while (true) {
+            if (table[j].rollNo == rollNo) {
+                marks = table[j].marks;
+                found = true;
+                return probes;
+            }
+            if (table[j].link == -1)
+                return probes;
+            j = table[j].link;
+            ++probes;
+        }
+    }
+};
+
+struct ProbeStats {
+    long long total = 0;
+    int maxProbe = 0;
+    int n = 0;
+
+    void add(int probes) {
+        total += probes;
+        maxProbe = max(maxProbe, probes);
+        ++n;
+    }
+
+    double mean() const { return n ? (double)total / n : 0; }
+};
+
+// Probe lengths and lookup time for one strategy at the given load
+template <class Table>
+void benchmark(const string& name, int size, double load) {
+    int n = (int)(size * load);
+
+    // Distinct random roll numbers: half are stored, half are used for misses
+    mt19937 rng(42);
+    vector<int> keys;
+    while ((int)keys.size() < 2 * n) {
+        while ((int)keys.size() < 2 * n)
+            keys.push_back((int)(rng() >> 1));
+        sort(keys.begin(), keys.end());
+        keys.erase(unique(keys.begin(), keys.end()), keys.end());
+    }
+    shuffle(keys.begin(), keys.end(), rng);
+
+    Table ht(size);
+    ProbeStats ins, hit, miss;
+    for (int i = 0; i < n; ++i)
+        ins.add(ht.insert(keys[i], i % 100));
+
+    int marks;
+    bool found;
+    auto t0 = chrono::steady_clock::now();
+    for (int i = 0; i < n; ++i)
+        hit.add(ht.search(keys[i], marks, found));
+    auto t1 = chrono::steady_clock::now();
+    for (int i = n; i < 2 * n; ++i)
+        miss.add(ht.search(keys[i], marks, found));
+    auto t2 = chrono::steady_clock::now();
+
+    cout << name << "\t" << ins.mean() << "/" << ins.maxProbe
+         << "\t\t" << hit.mean() << "/" << hit.maxProbe
+         << "\t\t" << miss.mean() << "/" << miss.maxProbe
+         << "\t\t" << chrono::duration<double, nano>(t1 - t0).count() / n
+         << "\t" << chrono::duration<double, nano>(t2 - t1).count() / n << "\n";
+}
+
+int main(int argc, char* argv[]) {
+    RobinHoodHashTable ht;
+
+    int rollNos[] = {31, 13, 14, 51, 16, 71, 48, 19};
+    int n = sizeof(rollNos) / sizeof(rollNos[0]);
+
+    for (int i = 0; i < n; ++i) {
+        ht.insert(rollNos[i], rollNos[i] + 50);
+    }
+
+    cout << "Final Hash Table (Robin Hood Hashing):\n";
+    ht.display();
+
+    ht.remove(51);
+    cout << "\nAfter deleting 51:\n";
+    ht.display();
+
+    int size = argc > 1 ? atoi(argv[1]) : 1000003;
+    double load = argc > 2 ? atof(argv[2]) : 0.9;
+    cout << "\nProbe length (mean/max) at load " << load << ", size " << size << ":\n";
+    cout << "Strategy\tInsert\t\tHit\t\tMiss\t\tHit ns\tMiss ns\n";
+    benchmark<WithoutReplacementHashTable>("W/o repl", size, load);
+    benchmark<WithReplacementHashTable>("With repl", size, load);
+    benchmark<RobinHoodHashTable>("RobinHood", size, load);
+
+    return 0;
+}
@@ -0,0 +1,371 @@
+// Consider the student database of N students and their marks. Make use of a hash table
+// implementation to quickly insert and lookup students' Rollno and marks.
+// Swiss table version: roll numbers and marks live in their own arrays and a separate array of
+// one-byte control codes (empty, deleted, or 7 bits of the hash) is scanned a whole group at a
+// time with SSE2 (16 slots) or AVX2 (32 slots) compares. A scalar loop is used when neither is
+// available. Same insert/search/remove/display interface as the HashTable in Ass1.cpp.
+// Usage: ./a.out [keys...]   e.g. ./a.out 1000000 10000000 100000000
+
+#include <iostream>
+#include <vector>
+#include <cstdint>
+#include <chrono>
+#include <random>
+#include <algorithm>
+#include <unordered_map>
+#include <cstdlib>
+#if defined(__AVX2__) || defined(__SSE2__)
+#include <immintrin.h>
+#endif
+using namespace std;
+
+const int SIZE = 10;
+
+const int8_t EMPTY = -128;   // 0x80
+const int8_t DELETED = -2;   // 0xFE
+
+#if defined(__AVX2__)
+const int GROUP_WIDTH = 32;
+#else
+const int GROUP_WIDTH = 16;
+#endif
+
+// One group of control bytes, loaded at once
+struct Group {
+#if defined(__AVX2__)
+    __m256i ctrl;
+
+    Group(const int8_t* p) { ctrl = _mm256_loadu_si256((const __m256i*)p); }
+
+    uint32_t match(int8_t h2) const {
+        return (uint32_t)_mm256_movemask_epi8(_mm256_cmpeq_epi8(ctrl, _mm256_set1_epi8(h2)));
+    }
+
+    uint32_t matchEmpty() const { return match(EMPTY); }
+
+    // Empty and deleted both have the sign bit set, full slots do not
+    uint32_t matchEmptyOrDeleted() const { return (uint32_t)_mm256_movemask_epi8(ctrl); }
+#elif defined(__SSE2__)
+    __m128i ctrl;
+
+    Group(const int8_t* p) { ctrl = _mm_loadu_si128((const __m128i*)p); }
+
+    uint32_t match(int8_t h2) const {
+        return (uint32_t)_mm_movemask_epi8(_mm_cmpeq_epi8(ctrl, _mm_set1_epi8(h2)));
+    }
+
+    uint32_t matchEmpty() const { return match(EMPTY); }
+
+    uint32_t matchEmptyOrDeleted() const { return (uint32_t)_mm_movemask_epi8(ctrl); }
+#else
+    const int8_t* ctrl;
+
+    Group(const int8_t* p) { ctrl = p; }
+
+    uint32_t match(int8_t h2) const {
+        uint32_t mask = 0;
+        for (int i = 0; i < GROUP_WIDTH; ++i)
+            if (ctrl[i] == h2)
+                mask |= 1u << i;
+        return mask;
+    }
+
+    uint32_t matchEmpty() const { return match(EMPTY); }
+
+    uint32_t matchEmptyOrDeleted() const {
+        uint32_t mask = 0;
+        for (int i = 0; i < GROUP_WIDTH; ++i)
+            if (ctrl[i] < 0)
+                mask |= 1u << i;
+        return mask;
+    }
+#endif
+};
+
+class SwissHashTable {
+    vector<int8_t> ctrl;
+    vector<int> rollNos;
+    vector<int> marksList;
+    size_t groups;          // number of groups, a power of two
+    size_t count = 0;
+    size_t deletedCount = 0;
+
+    // murmur3 finalizer: spreads sequential roll numbers over all bits
+    static uint64_t hashFunction(int rollNo) {
+        uint64_t h = (uint64_t)(uint32_t)rollNo;
+        h ^= h >> 33;
+        h *= 0xff51afd7ed558ccdULL;
+        h ^= h >> 33;
+        h *= 0xc4ceb9fe1a85ec53ULL;
+        h ^= h >> 33;
+        return h;
+    }
+
+    static int8_t h2(uint64_t h) { return (int8_t)(h & 0x7F); }
+    size_t h1(uint64_t h) const { return (size_t)(h >> 7) & (groups - 1); }
+
+    static int lowestBit(uint32_t mask) { return __builtin_ctz(mask); }
+
+    size_t capacity() const { return groups * GROUP_WIDTH; }
+
+    // Slot holding rollNo, or -1
+    long find(int rollNo) const {
+        uint64_t h = hashFunction(rollNo);
+        size_t g = h1(h);
+        // Triangular probing visits every group when the count is a power of two
+        for (size_t step = 1; step <= groups; ++step) {
+            const int8_t* base = &ctrl[g * GROUP_WIDTH];
+            Group group(base);
+            for (uint32_t m = group.match(h2(h)); m != 0; m &= m - 1) {
+                size_t slot = g * GROUP_WIDTH + lowestBit(m);
+                if (rollNos[slot] == rollNo)
+                    return (long)slot;
+            }
+            if (group.matchEmpty())
+                return -1;
+            g = (g + step) & (groups - 1);
+        }
+        return -1;
+    }
+
+    void resize(size_t newGroups) {
+        vector<int8_t> oldCtrl(newGroups * GROUP_WIDTH, EMPTY);
+        vector<int> oldRollNos(newGroups * GROUP_WIDTH);
+        vector<int> oldMarks(newGroups * GROUP_WIDTH);
+        oldCtrl.swap(ctrl);
+        oldRollNos.swap(rollNos);
+        oldMarks.swap(marksList);
+        groups = newGroups;
+        count = 0;
+        deletedCount = 0;
+
+        for (size_t i = 0; i < oldCtrl.size(); ++i)
+            if (oldCtrl[i] >= 0)
+                place(oldRollNos[i], oldMarks[i]);
+    }
+
+    // Store a roll number known not to be present
+    void place(int rollNo, int marks) {
+        uint64_t h = hashFunction(rollNo);
+        size_t g = h1(h);
+        for (size_t step = 1;; ++step) {
+            uint32_t m = Group(&ctrl[g * GROUP_WIDTH]).matchEmptyOrDeleted();
+            if (m != 0) {
+                size_t slot = g * GROUP_WIDTH + lowestBit(m);
+                if (ctrl[slot] == DELETED)
+                    --deletedCount;
+                ctrl[slot] = h2(h);
+                rollNos[slot] = rollNo;
+                marksList[slot] = marks;
+                ++count;
+                return;
+            }
+            g = (g + step) & (groups - 1);
+        }
+    }
+
+public:
+    SwissHashTable(int size = SIZE) {
+        groups = 1;
+        while (groups * GROUP_WIDTH * 7 / 8 < (size_t)size)
+            groups *= 2;
+        ctrl.assign(capacity(), EMPTY);
+        rollNos.resize(capacity());
+        marksList.resize(capacity());
+    }
+
+    // Insert a roll number and marks; an existing roll number gets its marks updated
+    void insert(int rollNo, int marks) {
+        long slot = find(rollNo);
+        if (slot != -1) {
+            marksList[slot] = marks;
+            return;
+        }
+        // Keep at most 7/8 of the slots used so every probe sequence meets an empty slot
+        if ((count + deletedCount + 1) * 8 > capacity() * 7)
+            resize(count * 2 >= capacity() * 7 / 8 ? groups * 2 : groups);
+        place(rollNo, marks);
+    }
+
+    bool search(int rollNo, int& marks) const {
+        long slot = find(rollNo);
+        if (slot == -1)
+            return false;
+        marks = marksList[slot];
+        return true;
+    }
+
+    bool remove(int rollNo) {
+        long slot = find(rollNo);
+        if (slot == -1)
+            return false;
+        // A group with an empty slot never sent a probe onwards, so the slot can be empty again
+        size_t g = (size_t)slot / GROUP_WIDTH;
+        if (Group(&ctrl[g * GROUP_WIDTH]).matchEmpty()) {
+            ctrl[slot] = EMPTY;
+        } else {
+            ctrl[slot] = DELETED;
+            ++deletedCount;
+        }
+        --count;
+        return true;
+    }
+
+    size_t size() const { return count; }
+
+    void display() const {
+        cout << "Index\tRollNo\tMarks\tCtrl\n";
+        for (size_t i = 0; i < capacity(); ++i) {
+            if (ctrl[i] >= 0)
+                cout << i << "\t" << rollNos[i] << "\t" << marksList[i] << "\t" << (int)ctrl[i] << "\n";
+            else if (ctrl[i] == DELETED)
+                cout << i << "\tDeleted\n";
+            else
+                cout << i << "\tEmpty\n";
+        }
+    }
+};
+
+// Linear probing with chaining without replacement (Ass1.cpp), sized up front for the benchmark
+class ChainingHashTable {
+    struct Slot {
+        int rollNo = -1;
+        int marks = 0;
+        int link = -1;
+        bool occupied = false;
+    };
+    vector<Slot> table;
+
+    int hashFunction(int rollNo) {
+        return rollNo % (int)table.size();
+    }
+
+public:
+    ChainingHashTable(int size = SIZE) : table(size) {}
+
+    void insert(int rollNo, int marks) {
+        int size = (int)table.size();
+        int index = hashFunction(rollNo);
+        int i = index;
+        while (table[i].occupied)
+            i = (i + 1) % size;
+        table[i].rollNo = rollNo;
+        table[i].marks = marks;
+        table[i].occupied = true;
+        if (i != index) {
+            int j = index;
+            while (table[j].link != -1)
+                j = table[j].link;
+            table[j].link = i;
+        }
+    }
+
+    bool search(int rollNo, int& marks) {
+        int j = hashFunction(rollNo);
+        if (!table[j].occupied)
+            return false;
+        while (j != -1) {
+            if (table[j].rollNo == rollNo) {
+                marks = table[j].marks;
+                return true;
+            }
+            j = table[j].link;
+        }
+        return false;
+    }
+};
+
+// Wraps std::unordered_map in the same interface
+class StdHashTable {
+    unordered_map<int, int> table;
+
+public:
+    StdHashTable(int size = SIZE) { table.reserve(size); }
+
+    void insert(int rollNo, int marks) { table[rollNo] = marks; }
+
+    bool search(int rollNo, int& marks) {
+        auto it = table.find(rollNo);
+        if (it == table.end())
+            return false;
+        marks = it->second;
+        return true;
+    }
+};
+
+template <class Table>
+void benchmark(const char* name, Table& ht, const vector<int>& keys, int n) {
+    auto t0 = chrono::steady_clock::now();
+    for (int i = 0; i < n; ++i)
+        ht.insert(keys[i], i % 100);
+    auto t1 = chrono::steady_clock::now();
+
+    int marks;
+    long long found = 0;
+    for (int i = 0; i < n; ++i)
+        found += ht.search(keys[i], marks);
+    auto t2 = chrono::steady_clock::now();
+    for (int i = n; i < 2 * n; ++i)
+        found += ht.search(keys[i], marks);
+    auto t3 = chrono::steady_clock::now();
+
+    cout << name << "\t" << chrono::duration<double, nano>(t1 - t0).count() / n
+         << "\t" << chrono::duration<double, nano>(t2 - t1).count() / n
+         << "\t" << chrono::duration<double, nano>(t3 - t2).count() / n
+         << "\t(" << found << " found)\n";
+}
+
+int main(int argc, char* argv[]) {
+    SwissHashTable ht;
+
+    int rollNos[] = {31, 13, 14, 51, 16, 71, 48, 19};
+    int n = sizeof(rollNos) / sizeof(rollNos[0]);
+
+    for (int i = 0; i < n; ++i) {
+        ht.insert(rollNos[i], rollNos[i] + 50);
+    }
+
+    cout << "Final Hash Table (Swiss Table, group width " << GROUP_WIDTH << "):\n";
+    ht.display();
+
+    int marks;
+    ht.remove(51);
+    if (ht.search(71, marks) && !ht.search(51, marks))
+        cout << "\nDeleted 51, RollNo 71 found with marks " << marks << "\n";
+
+    vector<int> sizes;
+    for (int i = 1; i < argc; ++i)
+        sizes.push_back(atoi(argv[i]));
+    if (sizes.empty())
+        sizes.push_back(1000000);
+
+    for (int keyCount : sizes) {
+        // Distinct random roll numbers: first half stored, second half used for misses
+        mt19937 rng(42);
+        vector<int> keys;
+        while ((int)keys.size() < 2 * keyCount) {
+            while ((int)keys.size() < 2 * keyCount)
+                keys.push_back((int)(rng() >> 1));
+            sort(keys.begin(), keys.end());
+            keys.erase(unique(keys.begin(), keys.end()), keys.end());
+        }
+        shuffle(keys.begin(), keys.end(), rng);
+
+        cout << "\n" << keyCount << " keys (ns per operation):\n";
+        cout << "Table\t\tInsert\tHit\tMiss\n";
+        {
+            SwissHashTable swiss(keyCount);
+            benchmark("Swiss\t", swiss, keys, keyCount);
+        }
+        {
+            ChainingHashTable chaining((int)(keyCount / 0.8));
+            benchmark("Ass1 chaining", chaining, keys, keyCount);
+        }
+        {
+            StdHashTable std(keyCount);
+            benchmark("unordered_map", std, keys, keyCount);
+        }
+    }
+
+    return 0;
+}
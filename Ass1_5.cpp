@@ -0,0 +1,279 @@
+// Consider the student database of N students and their marks. Make use of a hash table
+// implementation to quickly insert and lookup students' Rollno and marks. Implement collision
+// handling techniques- linear probing with chaining without replacement.
+// Concurrent version: any number of threads can search while writers insert and delete.
+// Readers take no lock. A record is fully written before the slot is marked full and before it
+// is linked into a chain, so a reader following links never sees half a record. Deletes bump a
+// sequence number (seqlock) because freeing a slot can change a chain under a reader, who then
+// retries. Writers are serialised by a mutex. When the table grows, the old one is kept until the
+// table is destroyed so readers still walking it never touch freed memory.
+// Compile with: g++ -O2 -pthread Ass1_5.cpp
+
+#include <iostream>
+#include <vector>
+#include <atomic>
+#include <mutex>
+#include <thread>
+#include <memory>
+#include <chrono>
+#include <random>
+#include <algorithm>
+#include <cstdlib>
+using namespace std;
+
+const int SIZE = 10;
+
+const int EMPTY = 0;
+const int FULL = 1;
+const int DELETED = 2;
+
+struct Student {
+    atomic<int> rollNo;
+    atomic<int> marks;
+    atomic<int> link;
+    atomic<int> state;
+
+    Student() : rollNo(-1), marks(0), link(-1), state(EMPTY) {}
+};
+
+struct Table {
+    int size;
+    unique_ptr<Student[]> slots;
+
+    Table(int n) : size(n), slots(new Student[n]) {}
+};
+
+class ConcurrentHashTable {
+    atomic<Table*> current;
+    vector<unique_ptr<Table>> tables;   // every table ever published, oldest first
+    atomic<unsigned> sequence{0};       // odd while a delete is changing chains
+    mutex writeLock;
+    int count = 0;
+    int tombstones = 0;
+    double maxLoadFactor;
+
+    static int hashFunction(int rollNo, int size) {
+        return rollNo % size;
+    }
+
+    // Slot holding rollNo in t, or -1. Safe to call without the lock.
+    static int find(const Table* t, int rollNo) {
+        int j = hashFunction(rollNo, t->size);
+        if (t->slots[j].state.load(memory_order_acquire) == EMPTY)
+            return -1;
+        while (j != -1) {
+            const Student& s = t->slots[j];
+            if (s.state.load(memory_order_acquire) == FULL && s.rollNo.load(memory_order_relaxed) == rollNo)
+                return j;
+            j = s.link.load(memory_order_acquire);
+        }
+        return -1;
+    }
+
+    // Linear probing with chaining without replacement; caller holds the lock
+    static void place(Table* t, int rollNo, int marks) {
+        int size = t->size;
+        int index = hashFunction(rollNo, size);
+        Student* slots = t->slots.get();
+
+        if (slots[index].state.load(memory_order_relaxed) == EMPTY) {
+            slots[index].rollNo.store(rollNo, memory_order_relaxed);
+            slots[index].marks.store(marks, memory_order_relaxed);
+            slots[index].state.store(FULL, memory_order_release);
+            return;
+        }
+
+        int i = (index + 1) % size;
+        while (slots[i].state.load(memory_order_relaxed) != EMPTY)
+            i = (i + 1) % size;
+
+        // Publish the record before it becomes reachable from the chain
+        slots[i].rollNo.store(rollNo, memory_order_relaxed);
+        slots[i].marks.store(marks, memory_order_relaxed);
+        slots[i].state.store(FULL, memory_order_release);
+
+        int j = index;
+        while (slots[j].link.load(memory_order_relaxed) != -1)
+            j = slots[j].link.load(memory_order_relaxed);
+        slots[j].link.store(i, memory_order_release);
+    }
+
+    // Copy the live records into a new table and publish it; caller holds the lock
+    void rebuild(int newSize) {
+        Table* old = current.load(memory_order_relaxed);
+        tables.push_back(unique_ptr<Table>(new Table(newSize)));
+        Table* t = tables.back().get();
+        for (int i = 0; i < old->size; ++i)
+            if (old->slots[i].state.load(memory_order_relaxed) == FULL)
+                place(t, old->slots[i].rollNo.load(memory_order_relaxed),
+                      old->slots[i].marks.load(memory_order_relaxed));
+        tombstones = 0;
+        current.store(t, memory_order_release);
+    }
+
+public:
+    ConcurrentHashTable(int size = SIZE, double loadFactor = 0.7) : maxLoadFactor(loadFactor) {
+        tables.push_back(unique_ptr<Table>(new Table(size)));
+        current.store(tables.back().get());
+    }
+
+    // Insert a roll number, or update the marks of one already stored
+    void insert(int rollNo, int marks) {
+        lock_guard<mutex> guard(writeLock);
+        Table* t = current.load(memory_order_relaxed);
+
+        int j = find(t, rollNo);
+        if (j != -1) {
+            t->slots[j].marks.store(marks, memory_order_release);
+            return;
+        }
+
+        // Tombstones still take slots, so they count towards the load
+        if (count + tombstones + 1 > maxLoadFactor * t->size) {
+            rebuild(count + 1 > maxLoadFactor * t->size / 2 ? t->size * 2 : t->size);
+            t = current.load(memory_order_relaxed);
+        }
+        place(t, rollNo, marks);
+        ++count;
+    }
+
+    // Lock-free lookup; retries if a delete changed the chains meanwhile
+    bool search(int rollNo, int& marks) const {
+        while (true) {
+            unsigned before = sequence.load(memory_order_acquire);
+            if (before & 1)
+                continue;
+            const Table* t = current.load(memory_order_acquire);
+            int j = find(t, rollNo);
+            int m = j == -1 ? 0 : t->slots[j].marks.load(memory_order_acquire);
+            atomic_thread_fence(memory_order_acquire);
+            if (sequence.load(memory_order_relaxed) == before) {
+                marks = m;
+                return j != -1;
+            }
+        }
+    }
+
+    // Delete by leaving a tombstone; tombstones at a chain tail are unlinked and freed
+    bool remove(int rollNo) {
+        lock_guard<mutex> guard(writeLock);
+        Table* t = current.load(memory_order_relaxed);
+        Student* slots = t->slots.get();
+
+        vector<int> path;
+        int j = hashFunction(rollNo, t->size);
+        if (slots[j].state.load(memory_order_relaxed) == EMPTY)
+            return false;
+        while (j != -1) {
+            path.push_back(j);
+            if (slots[j].state.load(memory_order_relaxed) == FULL && slots[j].rollNo.load(memory_order_relaxed) == rollNo)
+                break;
+            j = slots[j].link.load(memory_order_relaxed);
+        }
+        if (j == -1)
+            return false;
+
+        sequence.fetch_add(1, memory_order_acq_rel);
+        slots[j].state.store(DELETED, memory_order_release);
+        ++tombstones;
+        --count;
+        while (path.size() > 1) {
+            int last = path.back();
+            if (slots[last].state.load(memory_order_relaxed) != DELETED || slots[last].link.load(memory_order_relaxed) != -1)
+                break;
+            path.pop_back();
+            slots[path.back()].link.store(-1, memory_order_release);
+            slots[last].state.store(EMPTY, memory_order_release);
+            --tombstones;
+        }
+        sequence.fetch_add(1, memory_order_release);
+        return true;
+    }
+
+    void display() {
+        lock_guard<mutex> guard(writeLock);
+        const Table* t = current.load(memory_order_relaxed);
+        cout << "Index\tRollNo\tMarks\tLink\n";
+        for (int i = 0; i < t->size; ++i) {
+            const Student& s = t->slots[i];
+            int state = s.state.load(memory_order_relaxed);
+            if (state == FULL)
+                cout << i << "\t" << s.rollNo.load() << "\t" << s.marks.load() << "\t" << s.link.load() << "\n";
+            else if (state == DELETED)
+                cout << i << "\tDeleted\t\t" << s.link.load() << "\n";
+            else
+                cout << i << "\tEmpty\n";
+        }
+    }
+};
+
+// Lookup throughput with 1..maxReaders reader threads while one loader thread keeps inserting
+void benchmark(int students, int maxReaders) {
+    vector<int> keys(2 * students);
+    for (int i = 0; i < 2 * students; ++i)
+        keys[i] = 100000 + i;
+    shuffle(keys.begin(), keys.end(), mt19937(42));
+
+    cout << "\nReaders\tLookups/s (total)\tPer reader\tLoader inserts/s\n";
+    for (int readers = 1; readers <= maxReaders; readers *= 2) {
+        ConcurrentHashTable ht(1024);
+        for (int i = 0; i < students; ++i)
+            ht.insert(keys[i], i % 100);
+
+        atomic<bool> stop{false};
+        atomic<long long> lookups{0};
+        long long inserted = 0;
+
+        auto start = chrono::steady_clock::now();
+        thread loader([&] {
+            for (int i = students; i < 2 * students && !stop.load(memory_order_relaxed); ++i) {
+                ht.insert(keys[i], i % 100);
+                ++inserted;
+            }
+        });
+        vector<thread> pool;
+        for (int r = 0; r < readers; ++r) {
+            pool.emplace_back([&, r] {
+                mt19937 rng(r);
+                long long done = 0;
+                int marks;
+                while (!stop.load(memory_order_relaxed)) {
+                    for (int k = 0; k < 1024; ++k)
+                        ht.search(keys[rng() % students], marks);
+                    done += 1024;
+                }
+                lookups += done;
+            });
+        }
+
+        this_thread::sleep_for(chrono::milliseconds(500));
+        stop = true;
+        for (thread& t : pool)
+            t.join();
+        loader.join();
+        double seconds = chrono::duration<double>(chrono::steady_clock::now() - start).count();
+
+        cout << readers << "\t" << lookups / seconds << "\t\t" << lookups / seconds / readers
+             << "\t\t" << inserted / seconds << "\n";
+    }
+}
+
+int main(int argc, char* argv[]) {
+    ConcurrentHashTable ht;
+
+    int rollNos[] = {31, 13, 14, 51, 16, 71, 48, 19};
+    int n = sizeof(rollNos) / sizeof(rollNos[0]);
+
+    for (int i = 0; i < n; ++i) {
+        ht.insert(rollNos[i], rollNos[i] + 50);
+    }
+
+    cout << "Final Hash Table (Concurrent, Linear Probing with Chaining Without Replacement):\n";
+    ht.display();
+
+    int students = argc > 1 ? atoi(argv[1]) : 1000000;
+    int maxReaders = argc > 2 ? atoi(argv[2]) : (int)max(1u, thread::hardware_concurrency());
+    benchmark(students, maxReaders);
+
+    return 0;
+}
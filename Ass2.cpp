@@ -2,31 +2,179 @@
 // hash table. Handle collision using separate chaining. After input is obtained, each word that the
 // user enters into the program is looked up within the hash table to see if it exists. If the user
 // entered word exists within the hash table, then that word is spelled correctly.
+// Usage: ./a.out [--flat] [--suggest] [--bloom[=rate]] [--threads=N] [dictionary-file [text-file]]
+//        ./a.out --hash-report word-file
+// With a dictionary file the table is sized to its word count and the lookup rate over the
+// text file (or the dictionary itself) is reported before the interactive prompt.
+// --flat uses FlatHashTable: all words in one character arena, found through an open-addressed
+// index whose entries cache part of the hash, so most mismatches never touch the word bytes.
+// --suggest also builds a SuggestionIndex and offers the closest words for a misspelling.
+// --bloom puts a Bloom filter (default false positive rate 0.01) in front of the table.
+// With a text file the table is also frozen into a FrozenDictionary that a pool of up to N
+// threads (default: one per core) checks the text against in parallel.
+// Compile with: g++ -O2 -pthread Ass2.cpp
 
 #include<iostream>
 #include<vector>
 #include<list>
 #include<string>
+#include<chrono>
+#include<cctype>
+#include<cstdint>
+#include<cstring>
+#include<algorithm>
+#include<cmath>
+#include<cstdlib>
+#include<fstream>
+#include<iterator>
+#include<thread>
+#include<mutex>
+#include<condition_variable>
+#include<functional>
+#include<deque>
+#include<fcntl.h>
+#include<sys/mman.h>
+#include<sys/stat.h>
+#include<unistd.h>
 
 using namespace std;
 
 const int TABLE_SIZE = 10;
 
+const vector<string> BUILTIN_WORDS = {
+    "apple", "banana", "grape", "orange", "melon",
+    "lemon", "cherry", "peach", "plum", "kiwi",
+    "mango", "pear", "lime", "apricot", "fig",
+    "date", "guava", "papaya", "coconut", "berry",
+    "nectarine", "lychee", "tangerine", "quince", "dragonfruit"
+};
+
+// Read-only memory mapping of a word file, split on whitespace without copying
+class MappedFile{
+    const char* data = nullptr;
+    size_t length = 0;
+
+public:
+    MappedFile(const string& path){
+        int fd = open(path.c_str(), O_RDONLY);
+        if(fd == -1){
+            return;
+        }
+        struct stat st;
+        if(fstat(fd, &st) == 0 && st.st_size > 0){
+            length = (size_t)st.st_size;
+            void* p = mmap(nullptr, length, PROT_READ, MAP_PRIVATE, fd, 0);
+            if(p != MAP_FAILED){
+                data = (const char*)p;
+                madvise(p, length, MADV_SEQUENTIAL);
+            }
+        }
+        close(fd);
+    }
+
+    ~MappedFile(){
+        if(data){
+            munmap((void*)data, length);
+        }
+    }
+
+    bool isOpen() const { return data != nullptr; }
+
+    // Calls f(start, length) for every whitespace-separated word
+    template<class F>
+    void forEachWord(F f) const {
+        size_t i = 0;
+        while(i < length){
+            while(i < length && isspace((unsigned char)data[i])) ++i;
+            size_t start = i;
+            while(i < length && !isspace((unsigned char)data[i])) ++i;
+            if(i > start){
+                f(data + start, i - start);
+            }
+        }
+    }
+};
+
+// 64-bit word hash in the style of wyhash. The word is read 4 or 8 bytes at a time and each
+// block is folded in with one 64x64->128 bit multiply, so there is no per-character work and
+// no division; a table reduces the result to a bucket once.
+const uint64_t HASH_SECRET[4] = {
+    0x2d358dccaa6c78a5ULL, 0x8bb84b93962eacc9ULL, 0x4b33a62ed433d4a3ULL, 0x4d5a2da51de1aa47ULL
+};
+
+inline uint64_t hashMix(uint64_t a, uint64_t b){
+    __uint128_t r = (__uint128_t)a * b;
+    return (uint64_t)r ^ (uint64_t)(r >> 64);
+}
+
+inline uint64_t read8(const char* p){ uint64_t v; memcpy(&v, p, 8); return v; }
+
+inline uint64_t read4(const char* p){ uint32_t v; memcpy(&v, p, 4); return v; }
+
+// Words over 16 bytes: 16 bytes per multiply, then the last 16 bytes as the final block.
+// Kept out of line so its loop is not inlined into hashWord, where it would bloat the
+// short-word path that almost every dictionary word takes.
+__attribute__((noinline)) void hashLongWord(const char* p, size_t n, uint64_t& seed,
+                                            uint64_t& a, uint64_t& b){
+    size_t i = n;
+    while(i > 16){
+        seed = hashMix(read8(p) ^ HASH_SECRET[1], read8(p + 8) ^ seed);
+        p += 16;
+        i -= 16;
+    }
+    a = read8(p + i - 16);
+    b = read8(p + i - 8);
+}
+
+inline uint64_t hashWord(const char* p, size_t n){
+    uint64_t seed = hashMix(HASH_SECRET[0], HASH_SECRET[1]);
+    uint64_t a, b;
+    if(n <= 16){
+        if(n >= 4){
+            // Two overlapping pairs of 4-byte reads cover any length from 4 to 16
+            size_t shift = (n >> 3) << 2;
+            a = read4(p) << 32 | read4(p + shift);
+            b = read4(p + n - 4) << 32 | read4(p + n - 4 - shift);
+        } else if(n > 0){
+            a = (uint64_t)(unsigned char)p[0] << 16 | (uint64_t)(unsigned char)p[n >> 1] << 8
+                | (unsigned char)p[n - 1];
+            b = 0;
+        } else {
+            a = b = 0;
+        }
+    } else {
+        hashLongWord(p, n, seed, a, b);
+    }
+    __uint128_t r = (__uint128_t)(a ^ HASH_SECRET[1]) * (b ^ seed);
+    return hashMix((uint64_t)r ^ HASH_SECRET[0] ^ n, (uint64_t)(r >> 64) ^ HASH_SECRET[1]);
+}
+
+// The original bucket function: base-31 polynomial reduced modulo size after every character.
+// Kept for hashReport().
+inline int polynomialHash(const char* p, size_t n, int size){
+    int hash = 0;
+    for(size_t i = 0; i < n; ++i){
+        hash = (hash*31 + p[i]) % size;
+    }
+    return hash;
+}
+
+class FrozenDictionary;
+
 class HashTable{
     vector<list<string>> table;
 
     int hashFunction(const string& word){
-        int hash = 0;
-        for(char ch: word){
-            hash = (hash*31 + ch) % TABLE_SIZE;
+        return hashFunction(word.data(), word.size());
+    }
 
-        }
-        return hash;
+    int hashFunction(const char* p, size_t n){
+        return (int)(hashWord(p, n) % table.size());
     }
 
 public:
-    HashTable(){
-        table.resize(TABLE_SIZE);
+    HashTable(int size = TABLE_SIZE){
+        table.resize(size);
     }
 
     void insert(const string& word){
@@ -45,26 +193,962 @@ public:
         return false;
     }
 
+    // Hooks for checkDocumentBatched: bucket of a word, prefetch it, search it
+    int locate(const char* p, size_t n){ return hashFunction(p, n); }
+
+    // Only the list header: the first node's address is in that header, so prefetching the
+    // node means waiting for the header's miss here. Tried both in this hook and as a second
+    // pass over the batch; neither beat this on a 1M-word dictionary (about 550 vs 600-700 ms
+    // for a 28 MB document), so the node miss is left to contains()
+    void prefetch(int index) const { __builtin_prefetch(&table[index]); }
+
+    bool contains(int index, const char* p, size_t n) const {
+        for(const string& w: table[index]){
+            if(w.size() == n && memcmp(w.data(), p, n) == 0){
+                return true;
+            }
+        }
+        return false;
+    }
+
+    vector<size_t> checkDocument(const string& text);
+
+    // Immutable copy that any number of threads can search at once
+    FrozenDictionary freeze() const;
+
+    template<class F>
+    void forEachWord(F f) const {
+        for(const list<string>& bucket: table){
+            for(const string& w: bucket){
+                f(w.data(), w.size());
+            }
+        }
+    }
+
+    size_t size() const { return table.size(); }
+
+    // Size the table for count words; only called while it is empty
+    void reserve(size_t count){
+        table.assign(max(count, (size_t)TABLE_SIZE), list<string>());
+    }
+
+    void loadDictionary() {
+        for (const string& word : BUILTIN_WORDS) {
+            insert(word);
+        }
+
+        cout << "Dictionary loaded with " << BUILTIN_WORDS.size() << " words.\n";
+    }
+
+};
+
+// Open addressing over a single character arena. Each index entry holds the word's offset
+// and length in the arena plus a 16-bit tag from the top of its hash.
+class FlatHashTable{
+    struct Entry{
+        uint32_t offset;
+        uint16_t length;    // 0 marks an empty entry
+        uint16_t tag;
+    };
+
+    vector<char> arena;
+    vector<Entry> index;    // size is a power of two, at most half full
+    size_t count = 0;
+
+    static uint64_t hashFunction(const char* p, size_t n){
+        return hashWord(p, n);
+    }
+
+    void grow(){
+        vector<Entry> old(index.size() * 2, Entry{0, 0, 0});
+        old.swap(index);
+        size_t mask = index.size() - 1;
+        for(const Entry& e: old){
+            if(e.length == 0){
+                continue;
+            }
+            size_t i = hashFunction(&arena[e.offset], e.length) & mask;
+            while(index[i].length != 0){
+                i = (i + 1) & mask;
+            }
+            index[i] = e;
+        }
+    }
+
+public:
+    FlatHashTable(int size = TABLE_SIZE){
+        reserve(size);
+    }
+
+    void reserve(size_t words){
+        size_t n = 16;
+        while(n < words * 2){
+            n *= 2;
+        }
+        if(n > index.size()){
+            index.assign(n, Entry{0, 0, 0});
+            arena.reserve(words * 8);
+        }
+    }
+
+    void insert(const string& word){
+        if(word.empty() || word.size() > UINT16_MAX){
+            return;
+        }
+        if((count + 1) * 2 > index.size()){
+            grow();
+        }
+        uint64_t h = hashFunction(word.data(), word.size());
+        uint16_t tag = (uint16_t)(h >> 48);
+        size_t mask = index.size() - 1;
+        size_t i = h & mask;
+        while(index[i].length != 0){
+            i = (i + 1) & mask;
+        }
+        index[i] = Entry{(uint32_t)arena.size(), (uint16_t)word.size(), tag};
+        arena.insert(arena.end(), word.begin(), word.end());
+        ++count;
+    }
+
+    bool search(const string& word){
+        return contains(locate(word.data(), word.size()), word.data(), word.size());
+    }
+
+    // Hooks for checkDocumentBatched: hash of a word, prefetch its index entry, search it
+    uint64_t locate(const char* p, size_t n) const { return hashFunction(p, n); }
+
+    void prefetch(uint64_t h) const { __builtin_prefetch(&index[h & (index.size() - 1)]); }
+
+    bool contains(uint64_t h, const char* p, size_t n) const {
+        uint16_t tag = (uint16_t)(h >> 48);
+        size_t mask = index.size() - 1;
+        for(size_t i = h & mask; index[i].length != 0; i = (i + 1) & mask){
+            const Entry& e = index[i];
+            if(e.tag == tag && e.length == n && memcmp(&arena[e.offset], p, n) == 0){
+                return true;
+            }
+        }
+        return false;
+    }
+
+    vector<size_t> checkDocument(const string& text);
+
+    FrozenDictionary freeze() const;
+
+    template<class F>
+    void forEachWord(F f) const {
+        for(const Entry& e: index){
+            if(e.length != 0){
+                f(&arena[e.offset], e.length);
+            }
+        }
+    }
+
+    size_t size() const { return index.size(); }
+
     void loadDictionary() {
-        vector<string> words = {
-            "apple", "banana", "grape", "orange", "melon",
-            "lemon", "cherry", "peach", "plum", "kiwi",
-            "mango", "pear", "lime", "apricot", "fig",
-            "date", "guava", "papaya", "coconut", "berry",
-            "nectarine", "lychee", "tangerine", "quince", "dragonfruit"
-        };
-
-        for (const string& word : words) {
+        for (const string& word : BUILTIN_WORDS) {
             insert(word);
         }
 
-        cout << "Dictionary loaded with " << words.size() << " words.\n";
+        cout << "Dictionary loaded with " << BUILTIN_WORDS.size() << " words.\n";
+    }
+};
+
+// Read-only dictionary made by freeze(). The words of each bucket sit next to each other in
+// one array (bucket b is entries[starts[b], starts[b + 1])), so a lookup reads one run of
+// entries and nothing is ever written after construction: threads share it without locks.
+class FrozenDictionary{
+    struct Entry{
+        uint32_t offset;
+        uint16_t length;
+        uint16_t tag;
+    };
+
+    vector<char> arena;
+    vector<uint32_t> starts;
+    vector<Entry> entries;
+    size_t mask = 0;
+
+public:
+    template<class Table>
+    explicit FrozenDictionary(const Table& table){
+        vector<pair<uint64_t, pair<const char*, size_t>>> words;
+        table.forEachWord([&](const char* p, size_t n){
+            words.push_back({hashWord(p, n), {p, n}});
+        });
+        size_t buckets = 1;
+        while(buckets < words.size()){
+            buckets *= 2;
+        }
+        mask = buckets - 1;
+
+        starts.assign(buckets + 1, 0);
+        for(const auto& w: words){
+            ++starts[(w.first & mask) + 1];
+        }
+        for(size_t b = 0; b < buckets; ++b){
+            starts[b + 1] += starts[b];
+        }
+        vector<uint32_t> next(starts.begin(), starts.end() - 1);
+        entries.resize(words.size());
+        for(const auto& w: words){
+            const char* p = w.second.first;
+            size_t n = w.second.second;
+            entries[next[w.first & mask]++] = Entry{(uint32_t)arena.size(), (uint16_t)n,
+                                                    (uint16_t)(w.first >> 48)};
+            arena.insert(arena.end(), p, p + n);
+        }
+    }
+
+    bool search(const string& word) const {
+        return contains(locate(word.data(), word.size()), word.data(), word.size());
+    }
+
+    // Hooks for checkDocumentBatched
+    uint64_t locate(const char* p, size_t n) const { return hashWord(p, n); }
+
+    void prefetch(uint64_t h) const { __builtin_prefetch(&starts[h & mask]); }
+
+    bool contains(uint64_t h, const char* p, size_t n) const {
+        uint16_t tag = (uint16_t)(h >> 48);
+        size_t b = h & mask;
+        for(uint32_t i = starts[b]; i < starts[b + 1]; ++i){
+            const Entry& e = entries[i];
+            if(e.tag == tag && e.length == n && memcmp(&arena[e.offset], p, n) == 0){
+                return true;
+            }
+        }
+        return false;
+    }
+
+    size_t words() const { return entries.size(); }
+};
+
+FrozenDictionary HashTable::freeze() const {
+    return FrozenDictionary(*this);
+}
+
+FrozenDictionary FlatHashTable::freeze() const {
+    return FrozenDictionary(*this);
+}
+
+// Fixed set of worker threads taking jobs from a shared queue
+class ThreadPool{
+    vector<thread> workers;
+    deque<function<void()>> jobs;
+    mutex lock;
+    condition_variable jobReady, allDone;
+    size_t running = 0;
+    bool stopping = false;
+
+    void work(){
+        while(true){
+            function<void()> job;
+            {
+                unique_lock<mutex> guard(lock);
+                jobReady.wait(guard, [&]{ return stopping || !jobs.empty(); });
+                if(jobs.empty()){
+                    return;
+                }
+                job = move(jobs.front());
+                jobs.pop_front();
+                ++running;
+            }
+            job();
+            {
+                lock_guard<mutex> guard(lock);
+                --running;
+                if(jobs.empty() && running == 0){
+                    allDone.notify_all();
+                }
+            }
+        }
+    }
+
+public:
+    explicit ThreadPool(int threads){
+        for(int i = 0; i < threads; ++i){
+            workers.emplace_back([this]{ work(); });
+        }
+    }
+
+    ~ThreadPool(){
+        {
+            lock_guard<mutex> guard(lock);
+            stopping = true;
+        }
+        jobReady.notify_all();
+        for(thread& t: workers){
+            t.join();
+        }
+    }
+
+    void submit(function<void()> job){
+        {
+            lock_guard<mutex> guard(lock);
+            jobs.push_back(move(job));
+        }
+        jobReady.notify_one();
+    }
+
+    // Block until every submitted job has finished
+    void wait(){
+        unique_lock<mutex> guard(lock);
+        allDone.wait(guard, [&]{ return jobs.empty() && running == 0; });
+    }
+
+    int size() const { return (int)workers.size(); }
+};
+
+// Spelling suggestions by symmetric deletion (SymSpell). Every dictionary word is indexed
+// under each string obtained by deleting up to MAX_DISTANCE characters from its first
+// PREFIX_LENGTH characters. Two words within edit distance 2 share such a deletion, so a query
+// only has to generate its own deletions, look them up, and check the few candidates found with
+// a real edit distance. Deletions are stored as 32-bit hashes next to the word number in one
+// sorted array; a hash collision only adds a candidate that the distance check throws away.
+class SuggestionIndex{
+    static const int MAX_DISTANCE = 2;
+    static const int PREFIX_LENGTH = 7;
+
+    vector<char> arena;         // all words back to back
+    vector<uint32_t> starts;    // word i is arena[starts[i], starts[i + 1])
+    vector<uint64_t> deletes;   // deletion hash << 32 | word number, sorted by build()
+
+    static uint32_t hashFunction(const char* p, size_t n){
+        return (uint32_t)hashWord(p, n);
+    }
+
+    // Distinct hashes of the deletions of up to MAX_DISTANCE characters from the word's prefix
+    static void deletionHashes(const char* word, size_t n, vector<uint32_t>& out){
+        out.clear();
+        char prefix[PREFIX_LENGTH];
+        char buffer[PREFIX_LENGTH];
+        size_t len = min(n, (size_t)PREFIX_LENGTH);
+        memcpy(prefix, word, len);
+
+        out.push_back(hashFunction(prefix, len));
+        for(size_t i = 0; i < len; ++i){
+            size_t k = 0;
+            for(size_t a = 0; a < len; ++a){
+                if(a != i) buffer[k++] = prefix[a];
+            }
+            out.push_back(hashFunction(buffer, k));
+            for(size_t j = i + 1; j < len; ++j){
+                size_t m = 0;
+                for(size_t a = 0; a < len; ++a){
+                    if(a != i && a != j) buffer[m++] = prefix[a];
+                }
+                out.push_back(hashFunction(buffer, m));
+            }
+        }
+        sort(out.begin(), out.end());
+        out.erase(unique(out.begin(), out.end()), out.end());
+    }
+
+    // Edit distance with adjacent transpositions, or bound + 1 once it must exceed bound
+    static int editDistance(const char* a, size_t n, const char* b, size_t m, int bound,
+                            vector<int>& prev2, vector<int>& prev, vector<int>& cur){
+        if((n > m ? n - m : m - n) > (size_t)bound){
+            return bound + 1;
+        }
+        prev2.assign(m + 1, 0);
+        prev.resize(m + 1);
+        cur.resize(m + 1);
+        for(size_t j = 0; j <= m; ++j){
+            prev[j] = (int)j;
+        }
+        for(size_t i = 1; i <= n; ++i){
+            cur[0] = (int)i;
+            int rowMin = cur[0];
+            for(size_t j = 1; j <= m; ++j){
+                int cost = a[i - 1] == b[j - 1] ? 0 : 1;
+                int d = min(min(prev[j] + 1, cur[j - 1] + 1), prev[j - 1] + cost);
+                if(i > 1 && j > 1 && a[i - 1] == b[j - 2] && a[i - 2] == b[j - 1]){
+                    d = min(d, prev2[j - 2] + 1);
+                }
+                cur[j] = d;
+                rowMin = min(rowMin, d);
+            }
+            if(rowMin > bound){
+                return bound + 1;
+            }
+            prev2.swap(prev);
+            prev.swap(cur);
+        }
+        return min(prev[m], bound + 1);
+    }
+
+public:
+    SuggestionIndex(){
+        starts.push_back(0);
+    }
+
+    void insert(const string& word){
+        vector<uint32_t> hashes;
+        deletionHashes(word.data(), word.size(), hashes);
+        uint64_t id = starts.size() - 1;
+        for(uint32_t h: hashes){
+            deletes.push_back((uint64_t)h << 32 | id);
+        }
+        arena.insert(arena.end(), word.begin(), word.end());
+        starts.push_back((uint32_t)arena.size());
+    }
+
+    // Sort the deletions once all words are inserted; suggest() needs it
+    void build(){
+        sort(deletes.begin(), deletes.end());
+    }
+
+    size_t words() const { return starts.size() - 1; }
+
+    size_t entries() const { return deletes.size(); }
+
+    string word(size_t i) const {
+        return string(&arena[starts[i]], starts[i + 1] - starts[i]);
+    }
+
+    // Up to k dictionary words within edit distance 2, closest first
+    vector<string> suggest(const string& word, size_t k) const {
+        vector<uint32_t> hashes;
+        deletionHashes(word.data(), word.size(), hashes);
+
+        vector<uint32_t> candidates;
+        for(uint32_t h: hashes){
+            auto it = lower_bound(deletes.begin(), deletes.end(), (uint64_t)h << 32);
+            for(; it != deletes.end() && (uint32_t)(*it >> 32) == h; ++it){
+                uint32_t id = (uint32_t)*it;
+                size_t len = starts[id + 1] - starts[id];
+                if((len > word.size() ? len - word.size() : word.size() - len) <= MAX_DISTANCE){
+                    candidates.push_back(id);
+                }
+            }
+        }
+        sort(candidates.begin(), candidates.end());
+        candidates.erase(unique(candidates.begin(), candidates.end()), candidates.end());
+
+        vector<pair<int, uint32_t>> found;
+        vector<int> prev2, prev, cur;
+        for(uint32_t id: candidates){
+            int d = editDistance(word.data(), word.size(), &arena[starts[id]],
+                                 starts[id + 1] - starts[id], MAX_DISTANCE, prev2, prev, cur);
+            if(d <= MAX_DISTANCE){
+                found.push_back({d, id});
+            }
+        }
+        // Closest first; words at the same distance in dictionary order
+        sort(found.begin(), found.end(), [&](const pair<int, uint32_t>& x, const pair<int, uint32_t>& y){
+            if(x.first != y.first){
+                return x.first < y.first;
+            }
+            return lexicographical_compare(&arena[starts[x.second]], &arena[starts[x.second + 1]],
+                                           &arena[starts[y.second]], &arena[starts[y.second + 1]]);
+        });
+
+        vector<string> result;
+        for(size_t i = 0; i < found.size() && i < k; ++i){
+            result.push_back(this->word(found[i].second));
+        }
+        return result;
     }
 };
 
-int main(){
-    HashTable hashTable;
-    hashTable.loadDictionary();
+// Blocked Bloom filter: each word sets and tests k bits inside a single 64-byte block, so a
+// query costs one cache miss however many bits it checks. "No" is always right; "maybe" is
+// wrong for about falsePositiveRate of the words not in the dictionary.
+class BloomFilter{
+    struct alignas(64) Block{
+        uint64_t bits[8];
+    };
+
+    vector<Block> blocks;
+    int probes = 0;
+
+    // Block from the high half of the hash, bit positions from a second mix of it
+    const Block& blockOf(uint64_t h) const {
+        return blocks[(size_t)(((h >> 32) * blocks.size()) >> 32)];
+    }
+
+    Block& blockOf(uint64_t h){
+        return blocks[(size_t)(((h >> 32) * blocks.size()) >> 32)];
+    }
+
+    template<class F>
+    void forEachBit(uint64_t h, F f) const {
+        uint64_t g = hashMix(h, HASH_SECRET[2]);
+        uint32_t a = (uint32_t)g, b = (uint32_t)(g >> 32) | 1;
+        for(int i = 0; i < probes; ++i){
+            f((a + i * b) >> 23);   // 0..511
+        }
+    }
+
+public:
+    BloomFilter(){}
+
+    // Probes and bits per word as for a standard Bloom filter, plus a fifth more bits because
+    // words crowd unevenly into blocks
+    BloomFilter(size_t words, double falsePositiveRate){
+        double bitsPerWord = -log(falsePositiveRate) / (log(2.0) * log(2.0));
+        probes = max(1, (int)round(bitsPerWord * log(2.0)));
+        size_t bits = (size_t)(max(words, (size_t)1) * bitsPerWord * 1.2);
+        blocks.assign(max((size_t)1, (bits + 511) / 512), Block{});
+    }
+
+    bool enabled() const { return !blocks.empty(); }
+
+    void insert(const char* p, size_t n){
+        uint64_t h = hashWord(p, n);
+        Block& block = blockOf(h);
+        forEachBit(h, [&](uint32_t bit){ block.bits[bit >> 6] |= 1ULL << (bit & 63); });
+    }
+
+    bool mayContain(const char* p, size_t n) const {
+        uint64_t h = hashWord(p, n);
+        const Block& block = blockOf(h);
+        bool all = true;
+        forEachBit(h, [&](uint32_t bit){ all &= (block.bits[bit >> 6] >> (bit & 63)) & 1; });
+        return all;
+    }
+
+    bool mayContain(const string& word) const { return mayContain(word.data(), word.size()); }
+
+    size_t bytes() const { return blocks.size() * sizeof(Block); }
+
+    int probeCount() const { return probes; }
+};
+
+// Calls f(offset, length) for every word of a text: a run of letters
+template<class F>
+void forEachToken(const char* text, size_t length, F f){
+    size_t i = 0;
+    while(i < length){
+        while(i < length && !isalpha((unsigned char)text[i])) ++i;
+        size_t start = i;
+        while(i < length && isalpha((unsigned char)text[i])) ++i;
+        if(i > start){
+            f(start, i - start);
+        }
+    }
+}
+
+// Offsets of the misspelled words in text. Words are lowercased and taken BATCH at a time:
+// the whole batch is hashed and its buckets prefetched before any lookup, so the cache misses
+// of one batch overlap instead of being paid one after another.
+template<class Table>
+vector<size_t> checkDocumentBatched(Table& hashTable, const char* text, size_t length){
+    const int BATCH = 16;
+    using Key = decltype(hashTable.locate(text, 0));
+
+    vector<size_t> misspelled;
+    string words;               // lowercased words of the current batch, back to back
+    size_t offsets[BATCH], starts[BATCH], lengths[BATCH];
+    Key keys[BATCH];
+    int n = 0;
+
+    auto flush = [&](){
+        for(int k = 0; k < n; ++k){
+            keys[k] = hashTable.locate(&words[starts[k]], lengths[k]);
+            hashTable.prefetch(keys[k]);
+        }
+        for(int k = 0; k < n; ++k){
+            if(!hashTable.contains(keys[k], &words[starts[k]], lengths[k])){
+                misspelled.push_back(offsets[k]);
+            }
+        }
+        n = 0;
+        words.clear();
+    };
+
+    forEachToken(text, length, [&](size_t offset, size_t len){
+        offsets[n] = offset;
+        starts[n] = words.size();
+        lengths[n] = len;
+        for(size_t i = 0; i < len; ++i){
+            words.push_back((char)tolower((unsigned char)text[offset + i]));
+        }
+        if(++n == BATCH){
+            flush();
+        }
+    });
+    flush();
+    return misspelled;
+}
+
+vector<size_t> HashTable::checkDocument(const string& text){
+    return checkDocumentBatched(*this, text.data(), text.size());
+}
+
+vector<size_t> FlatHashTable::checkDocument(const string& text){
+    return checkDocumentBatched(*this, text.data(), text.size());
+}
+
+// checkDocument split across a thread pool: the text is cut into chunks at non-letters, each
+// worker checks one chunk against the shared frozen dictionary, and the offsets are joined
+// back in text order.
+vector<size_t> checkDocumentParallel(const FrozenDictionary& dictionary, ThreadPool& pool,
+                                     const char* text, size_t length){
+    size_t chunks = (size_t)pool.size() * 4;
+    size_t chunkSize = length / chunks + 1;
+    vector<size_t> bounds = {0};
+    while(bounds.back() < length){
+        size_t end = min(length, bounds.back() + chunkSize);
+        while(end < length && isalpha((unsigned char)text[end])){
+            ++end;
+        }
+        bounds.push_back(end);
+    }
+
+    vector<vector<size_t>> results(bounds.size() - 1);
+    for(size_t c = 0; c + 1 < bounds.size(); ++c){
+        pool.submit([&, c]{
+            results[c] = checkDocumentBatched(dictionary, text + bounds[c], bounds[c + 1] - bounds[c]);
+            for(size_t& offset: results[c]){
+                offset += bounds[c];
+            }
+        });
+    }
+    pool.wait();
+
+    vector<size_t> misspelled;
+    for(const vector<size_t>& r: results){
+        misspelled.insert(misspelled.end(), r.begin(), r.end());
+    }
+    return misspelled;
+}
+
+// Load one word per whitespace-separated token of a file. The words are counted first
+// so the table is sized once.
+template<class Table>
+bool loadDictionary(Table& hashTable, const string& path) {
+    auto start = chrono::steady_clock::now();
+    MappedFile file(path);
+    if(!file.isOpen()){
+        cout << "Cannot open dictionary " << path << "\n";
+        return false;
+    }
+
+    size_t count = 0;
+    file.forEachWord([&](const char*, size_t){ ++count; });
+    hashTable.reserve(count);
+
+    string word;
+    file.forEachWord([&](const char* p, size_t n){
+        word.assign(p, n);
+        hashTable.insert(word);
+    });
+
+    double ms = chrono::duration<double, milli>(chrono::steady_clock::now() - start).count();
+    cout << "Dictionary loaded with " << count << " words from " << path << " in " << ms
+         << " ms (" << hashTable.size() << " buckets).\n";
+    return true;
+}
+
+// Look up every word of a file and report throughput
+template<class Table>
+void lookupBenchmark(Table& hashTable, const string& path){
+    MappedFile file(path);
+    if(!file.isOpen()){
+        return;
+    }
+
+    size_t words = 0, found = 0;
+    string word;
+    auto start = chrono::steady_clock::now();
+    file.forEachWord([&](const char* p, size_t n){
+        word.assign(p, n);
+        found += hashTable.search(word);
+        ++words;
+    });
+    double seconds = chrono::duration<double>(chrono::steady_clock::now() - start).count();
+    cout << "Looked up " << words << " words (" << found << " found) at "
+         << words / seconds << " words/sec.\n";
+}
+
+// Check a whole text file word by word with search(), then with one checkDocument() call
+template<class Table>
+void documentBenchmark(Table& hashTable, const string& path){
+    ifstream file(path, ios::binary);
+    if(!file){
+        return;
+    }
+    string text((istreambuf_iterator<char>(file)), istreambuf_iterator<char>());
+
+    auto t0 = chrono::steady_clock::now();
+    size_t wordByWord = 0;
+    string word;
+    forEachToken(text.data(), text.size(), [&](size_t offset, size_t len){
+        word.assign(text, offset, len);
+        for(char& ch: word){
+            ch = (char)tolower((unsigned char)ch);
+        }
+        if(!hashTable.search(word)){
+            ++wordByWord;
+        }
+    });
+    auto t1 = chrono::steady_clock::now();
+    vector<size_t> misspelled = hashTable.checkDocument(text);
+    auto t2 = chrono::steady_clock::now();
+
+    double mb = text.size() / 1e6;
+    cout << "Document of " << mb << " MB: word by word "
+         << chrono::duration<double, milli>(t1 - t0).count() << " ms (" << wordByWord
+         << " misspelled), checkDocument " << chrono::duration<double, milli>(t2 - t1).count()
+         << " ms (" << misspelled.size() << " misspelled).\n";
+}
+
+// Bucket occupancy of one hash function over a word list at the given table size
+template<class F>
+void bucketReport(const string& name, const vector<string>& words, size_t buckets, F bucketOf){
+    vector<uint32_t> chain(buckets, 0);
+    auto start = chrono::steady_clock::now();
+    for(const string& w: words){
+        ++chain[bucketOf(w, buckets)];
+    }
+    double ns = chrono::duration<double, nano>(chrono::steady_clock::now() - start).count();
+
+    size_t used = 0;
+    uint32_t longest = 0;
+    double squares = 0;
+    for(uint32_t c: chain){
+        used += c != 0;
+        longest = max(longest, c);
+        squares += (double)c * c;
+    }
+    double n = (double)words.size();
+    // Mean chain length met by a successful search, and sum of squares over its value for a
+    // uniformly random function (1.0 is ideal, larger means clustering)
+    double probes = (squares + n) / (2 * n);
+    double uniform = n + n * (n - 1) / buckets;
+    cout << name << "\t" << buckets << "\t" << 100.0 * used / buckets << "%\t" << longest
+         << "\t" << probes << "\t" << squares / uniform << "\t" << ns / n << "\n";
+}
+
+// Compare the old per-character modulo hash with hashWord on the words of a file
+void hashReport(const string& path){
+    vector<string> words;
+    MappedFile file(path);
+    file.forEachWord([&](const char* p, size_t n){ words.push_back(string(p, n)); });
+    sort(words.begin(), words.end());
+    words.erase(unique(words.begin(), words.end()), words.end());
+    if(words.empty()){
+        cout << "No words in " << path << "\n";
+        return;
+    }
+
+    vector<uint64_t> full;
+    for(const string& w: words){
+        full.push_back(hashWord(w.data(), w.size()));
+    }
+    sort(full.begin(), full.end());
+    size_t collisions = full.size() - (unique(full.begin(), full.end()) - full.begin());
+
+    cout << "Hash distribution over " << words.size() << " words of " << path
+         << " (" << collisions << " full 64-bit collisions for hashWord):\n";
+    cout << "Hash\t\tBuckets\tUsed\tLongest\tProbes\tSq/unif\tns/word\n";
+    size_t power = 1;
+    while(power < words.size()){
+        power *= 2;
+    }
+    for(size_t buckets: {(size_t)TABLE_SIZE, (size_t)1009, words.size(), power}){
+        bucketReport("polynomial %", words, buckets, [](const string& w, size_t m){
+            return (size_t)polynomialHash(w.data(), w.size(), (int)m);
+        });
+        bucketReport("hashWord\t", words, buckets, [](const string& w, size_t m){
+            return (size_t)(hashWord(w.data(), w.size()) % m);
+        });
+    }
+}
+
+// Freeze the table and check a text with 1, 2, 4 ... maxThreads workers
+template<class Table>
+void threadBenchmark(const Table& hashTable, const string& path, int maxThreads){
+    ifstream file(path, ios::binary);
+    if(!file){
+        return;
+    }
+    string text((istreambuf_iterator<char>(file)), istreambuf_iterator<char>());
+
+    auto start = chrono::steady_clock::now();
+    FrozenDictionary dictionary = hashTable.freeze();
+    double ms = chrono::duration<double, milli>(chrono::steady_clock::now() - start).count();
+    cout << "Frozen " << dictionary.words() << " words in " << ms << " ms.\n";
+    cout << "Threads\tms\tMB/s\tMisspelled\n";
+
+    double mb = text.size() / 1e6;
+    for(int threads = 1;; threads = min(threads * 2, maxThreads)){
+        ThreadPool pool(threads);
+        auto t0 = chrono::steady_clock::now();
+        vector<size_t> misspelled = checkDocumentParallel(dictionary, pool, text.data(), text.size());
+        double seconds = chrono::duration<double>(chrono::steady_clock::now() - t0).count();
+        cout << threads << "\t" << seconds * 1000 << "\t" << mb / seconds << "\t"
+             << misspelled.size() << "\n";
+        if(threads == maxThreads){
+            break;
+        }
+    }
+}
+
+// Bloom filter over the dictionary words, sized for their count
+BloomFilter buildBloomFilter(const vector<string>& args, double falsePositiveRate){
+    size_t count = 0;
+    BloomFilter bloom;
+    if(args.empty()){
+        count = BUILTIN_WORDS.size();
+        bloom = BloomFilter(count, falsePositiveRate);
+        for(const string& word: BUILTIN_WORDS){
+            bloom.insert(word.data(), word.size());
+        }
+    } else {
+        MappedFile file(args[0]);
+        file.forEachWord([&](const char*, size_t){ ++count; });
+        bloom = BloomFilter(count, falsePositiveRate);
+        file.forEachWord([&](const char* p, size_t n){ bloom.insert(p, n); });
+    }
+    cout << "Bloom filter over " << count << " words: " << bloom.bytes() / 1024 << " KB, "
+         << bloom.probeCount() << " probes per word, target false positive rate "
+         << falsePositiveRate << ".\n";
+    return bloom;
+}
+
+// Queries that are mostly misspelled: dictionary words with the last letter changed, plus
+// one correct word in ten. Times search() alone and behind the Bloom filter.
+template<class Table>
+void bloomBenchmark(Table& hashTable, const BloomFilter& bloom, const string& path){
+    vector<string> queries;
+    uint64_t seed = 7;
+    MappedFile file(path);
+    file.forEachWord([&](const char* p, size_t n){
+        seed = seed * 6364136223846793005ULL + 1442695040888963407ULL;
+        string word(p, n);
+        if((seed >> 33) % 10 != 0){
+            word.back() = (char)('a' + (seed >> 40) % 26);
+            word += (char)('a' + (seed >> 50) % 26);
+        }
+        queries.push_back(word);
+    });
+    if(queries.empty()){
+        return;
+    }
+
+    auto t0 = chrono::steady_clock::now();
+    size_t found = 0;
+    for(const string& q: queries){
+        found += hashTable.search(q);
+    }
+    auto t1 = chrono::steady_clock::now();
+    size_t foundFiltered = 0, passed = 0;
+    for(const string& q: queries){
+        if(bloom.mayContain(q)){
+            ++passed;
+            foundFiltered += hashTable.search(q);
+        }
+    }
+    auto t2 = chrono::steady_clock::now();
+
+    double n = (double)queries.size();
+    size_t misses = queries.size() - found;
+    cout << "Miss-heavy lookups (" << 100.0 * misses / n << "% misses): search "
+         << chrono::duration<double, nano>(t1 - t0).count() / n << " ns/word, Bloom + search "
+         << chrono::duration<double, nano>(t2 - t1).count() / n << " ns/word ("
+         << found << " vs " << foundFiltered << " found, measured false positive rate "
+         << (misses ? (double)(passed - foundFiltered) / misses : 0.0) << ").\n";
+}
+
+// Index the same words as the dictionary for suggestions
+void loadSuggestions(SuggestionIndex& suggestions, const vector<string>& args){
+    auto start = chrono::steady_clock::now();
+    if(args.empty()){
+        for(const string& word: BUILTIN_WORDS){
+            suggestions.insert(word);
+        }
+    } else {
+        MappedFile file(args[0]);
+        string word;
+        file.forEachWord([&](const char* p, size_t n){
+            word.assign(p, n);
+            suggestions.insert(word);
+        });
+    }
+    suggestions.build();
+    double ms = chrono::duration<double, milli>(chrono::steady_clock::now() - start).count();
+    cout << "Suggestion index built over " << suggestions.words() << " words ("
+         << suggestions.entries() << " deletions) in " << ms << " ms.\n";
+}
+
+// Misspell random dictionary words with one or two edits and time suggest() on them
+void suggestionBenchmark(const SuggestionIndex& suggestions, int queries){
+    if(suggestions.words() == 0){
+        return;
+    }
+    uint64_t seed = 42;
+    auto next = [&](uint64_t bound){
+        seed = seed * 6364136223846793005ULL + 1442695040888963407ULL;
+        return (seed >> 33) % bound;
+    };
+
+    double totalMs = 0, maxMs = 0;
+    int recalled = 0;
+    for(int q = 0; q < queries; ++q){
+        string original = suggestions.word(next(suggestions.words()));
+        string query = original;
+        int edits = 1 + (int)next(2);
+        for(int e = 0; e < edits; ++e){
+            size_t pos = next(query.size() + 1);
+            char ch = (char)('a' + next(26));
+            switch(next(3)){
+            case 0:
+                query.insert(query.begin() + pos, ch);
+                break;
+            case 1:
+                if(pos < query.size() && query.size() > 1) query.erase(pos, 1);
+                break;
+            default:
+                if(pos < query.size()) query[pos] = ch;
+                break;
+            }
+        }
+
+        auto start = chrono::steady_clock::now();
+        vector<string> result = suggestions.suggest(query, 10);
+        double ms = chrono::duration<double, milli>(chrono::steady_clock::now() - start).count();
+        totalMs += ms;
+        maxMs = max(maxMs, ms);
+        recalled += find(result.begin(), result.end(), original) != result.end();
+    }
+    cout << "Suggested for " << queries << " misspellings: " << totalMs / queries
+         << " ms mean, " << maxMs << " ms max, original word among the top 10 for "
+         << recalled << ".\n";
+}
+
+template<class Table>
+int run(const vector<string>& args, bool suggest, double bloomRate, int maxThreads){
+    Table hashTable;
+    if(!args.empty()){
+        if(!loadDictionary(hashTable, args[0])){
+            return 1;
+        }
+        lookupBenchmark(hashTable, args.size() > 1 ? args[1] : args[0]);
+        if(args.size() > 1){
+            documentBenchmark(hashTable, args[1]);
+            threadBenchmark(hashTable, args[1], maxThreads);
+        }
+    } else {
+        hashTable.loadDictionary();
+    }
+
+    BloomFilter bloom;
+    if(bloomRate > 0){
+        bloom = buildBloomFilter(args, bloomRate);
+        if(!args.empty()){
+            bloomBenchmark(hashTable, bloom, args[0]);
+        }
+    }
+
+    SuggestionIndex suggestions;
+    if(suggest){
+        loadSuggestions(suggestions, args);
+        suggestionBenchmark(suggestions, 10000);
+    }
 
     string input;
     cout << "\nEnter words to check spelling (type 'exit' to stop):\n";
@@ -72,18 +1156,68 @@ int main(){
     while(true){
         cout << "> ";
 
-        cin>>input;
-
-        if(input == "exit"){
+        if(!(cin>>input) || input == "exit"){
             break;
         }
-        if(hashTable.search(input)){
+        // A word the Bloom filter rules out is never looked up in the table
+        if((!bloom.enabled() || bloom.mayContain(input)) && hashTable.search(input)){
             cout << input << " is spelled correctly.\n";
         } else {
             cout << input << " is not found in the dictionary.\n";
+            if(suggest){
+                vector<string> similar = suggestions.suggest(input, 5);
+                if(!similar.empty()){
+                    cout << "Did you mean:";
+                    for(const string& w: similar){
+                        cout << " " << w;
+                    }
+                    cout << "\n";
+                }
+            }
         }
     }
+    return 0;
+}
 
+int main(int argc, char* argv[]){
+    vector<string> args;
+    bool flat = false, suggest = false, report = false;
+    double bloomRate = 0;
+    int maxThreads = (int)max(1u, thread::hardware_concurrency());
+    for(int i = 1; i < argc; ++i){
+        string arg = argv[i];
+        if(arg == "--flat"){
+            flat = true;
+        } else if(arg == "--suggest"){
+            suggest = true;
+        } else if(arg == "--hash-report"){
+            report = true;
+        } else if(arg == "--bloom"){
+            bloomRate = 0.01;
+        } else if(arg.compare(0, 8, "--bloom=") == 0){
+            bloomRate = atof(arg.c_str() + 8);
+            if(bloomRate <= 0 || bloomRate >= 1){
+                cout << "--bloom= needs a false positive rate between 0 and 1\n";
+                return 1;
+            }
+        } else if(arg.compare(0, 10, "--threads=") == 0){
+            maxThreads = max(1, atoi(arg.c_str() + 10));
+        } else {
+            args.push_back(arg);
+        }
+    }
+    if(report){
+        if(args.empty()){
+            cout << "--hash-report needs a word file\n";
+            return 1;
+        }
+        hashReport(args[0]);
+        return 0;
+    }
+    if(flat){
+        return run<FlatHashTable>(args, suggest, bloomRate, maxThreads);
+    }
+    return run<HashTable>(args, suggest, bloomRate, maxThreads);
 }
 
 // **Evaluating code explanation request**
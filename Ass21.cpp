@@ -5,11 +5,27 @@
 // Create a hash table of size 10.
 // Linear probing with chaining with replacement: Insert the following PNR: (11,
 // 21,31,34,55,52,33)
+// Usage: ./a.out                     the test case above
+//        ./a.out size [snapshot]     also the benchmarks: lookups and loading at high load
+//                                    of a table of size, snapshot of snapshot records (1M)
 
 #include <iostream>
+#include <vector>
+#include <chrono>
+#include <random>
+#include <algorithm>
+#include <cstdlib>
+#include <cstring>
+#include <cstdint>
+#include <fstream>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
 using namespace std;
 
 const int SIZE = 10;
+const char* SNAPSHOT_FILE = "students_pnr_hash.dat";
 
 struct Student {
     int pnr;
@@ -25,69 +41,191 @@ struct Student {
     }
 };
 
+// Snapshot file: this header followed by the slot array exactly as it is in memory
+struct SnapshotHeader {
+    char magic[8];
+    int slotSize;   // sizeof(Student) of the program that wrote it
+    int size;       // number of slots
+};
+
+const char SNAPSHOT_MAGIC[8] = "HTSNAP1";
+
 class HashTable {
-    Student table[SIZE];
+    vector<Student> table;
+
+    // Bookkeeping kept beside the slots (not saved in snapshots) so insert never scans:
+    // a bitmap of free slots, the slot linking to each slot, and the last slot of the chain
+    // headed at each home slot
+    vector<uint64_t> freeSlots;     // bit i set = slot i is free
+    int freeCount;
+    vector<int> prevSlot;
+    vector<int> chainTail;
 
     int hashFunction(int pnr) {
-        return pnr % SIZE;
+        return pnr % (int)table.size();
+    }
+
+    void markUsed(int i) {
+        freeSlots[i / 64] &= ~(1ULL << (i % 64));
+        --freeCount;
+    }
+
+    void markFree(int i) {
+        freeSlots[i / 64] |= 1ULL << (i % 64);
+        ++freeCount;
+    }
+
+    // First free slot after home (wrapping around), or -1 if the table is full.
+    // Reads the bitmap 64 slots at a time.
+    int findFreeSlot(int home) {
+        if (freeCount == 0)
+            return -1;
+        int start = (home + 1) % (int)table.size();
+        size_t words = freeSlots.size();
+        size_t w = start / 64;
+        uint64_t bits = freeSlots[w] & (~0ULL << (start % 64));
+        for (size_t k = 0; k <= words; ++k) {
+            if (bits != 0)
+                return (int)(w * 64 + __builtin_ctzll(bits));
+            w = (w + 1) % words;
+            bits = freeSlots[w];
+        }
+        return -1;
+    }
+
+    void place(int i, int pnr, int marks) {
+        table[i].pnr = pnr;
+        table[i].marks = marks;
+        table[i].occupied = true;
+        table[i].link = -1;
+        markUsed(i);
     }
 
 public:
-    void insert(int pnr, int marks) {
+    HashTable(int size = SIZE) : table(size), freeSlots((size + 63) / 64, 0), freeCount(0),
+                                 prevSlot(size, -1), chainTail(size, -1) {
+        for (int i = 0; i < size; ++i)
+            markFree(i);
+    }
+
+    // Returns false if the table is full
+    bool insert(int pnr, int marks) {
         int home = hashFunction(pnr);
 
         if (!table[home].occupied) {
             // Empty home slot
-            table[home].pnr = pnr;
-            table[home].marks = marks;
-            table[home].occupied = true;
-            return;
+            place(home, pnr, marks);
+            prevSlot[home] = -1;
+            chainTail[home] = home;
+            return true;
+        }
+
+        int i = findFreeSlot(home);
+        if (i == -1) {
+            cout << "Hash table is full!\n";
+            return false;
         }
 
         int existingHome = hashFunction(table[home].pnr);
         if (existingHome != home) {
-            // Replacement needed: current slot occupied by a displaced record
-            Student displaced = table[home];
+            // Replacement needed: current slot occupied by a displaced record.
+            // Move it (with the rest of its chain) to the free slot and relink its predecessor.
+            int prev = prevSlot[home];
+            table[i] = table[home];
+            markUsed(i);
+            table[prev].link = i;
+            prevSlot[i] = prev;
+            if (table[i].link != -1)
+                prevSlot[table[i].link] = i;
+            if (chainTail[existingHome] == home)
+                chainTail[existingHome] = i;
 
             // Insert new at correct home
-            table[home].pnr = pnr;
-            table[home].marks = marks;
-            table[home].occupied = true;
-            table[home].link = -1;
-
-            // Reinsert displaced student elsewhere
-            int i = (home + 1) % SIZE;
-            while (table[i].occupied)
-                i = (i + 1) % SIZE;
-
-            table[i] = displaced;
-
-            // Update link of correct home of displaced
-            int dispHome = hashFunction(displaced.pnr);
-            while (table[dispHome].link != -1)
-                dispHome = table[dispHome].link;
-            table[dispHome].link = i;
+            markFree(home);
+            place(home, pnr, marks);
+            prevSlot[home] = -1;
+            chainTail[home] = home;
         } else {
-            // Collision, find next slot
-            int i = (home + 1) % SIZE;
-            while (table[i].occupied)
-                i = (i + 1) % SIZE;
-
-            table[i].pnr = pnr;
-            table[i].marks = marks;
-            table[i].occupied = true;
-
-            // Chain from home
-            int j = home;
-            while (table[j].link != -1)
-                j = table[j].link;
+            // Collision, place at the free slot and append it to the chain from home
+            place(i, pnr, marks);
+            int j = chainTail[home];
             table[j].link = i;
+            prevSlot[i] = j;
+            chainTail[home] = i;
         }
+        return true;
+    }
+
+    // Look up marks for a PNR. With replacement the home slot always heads its own chain.
+    bool search(int pnr, int& marks) {
+        int j = hashFunction(pnr);
+        if (!table[j].occupied || hashFunction(table[j].pnr) != j)
+            return false;
+
+        while (j != -1) {
+            if (table[j].pnr == pnr) {
+                marks = table[j].marks;
+                return true;
+            }
+            j = table[j].link;
+        }
+        return false;
+    }
+
+    // Delete a PNR and unlink it from its chain. Removing a chain head pulls the
+    // next record into the home slot, so no tombstones are needed.
+    bool remove(int pnr) {
+        int home = hashFunction(pnr);
+        if (!table[home].occupied || hashFunction(table[home].pnr) != home)
+            return false;
+
+        int prev = -1, j = home;
+        while (j != -1 && table[j].pnr != pnr) {
+            prev = j;
+            j = table[j].link;
+        }
+        if (j == -1)
+            return false;
+
+        if (prev == -1 && table[j].link != -1) {
+            int next = table[j].link;
+            table[j] = table[next];
+            if (table[j].link != -1)
+                prevSlot[table[j].link] = j;
+            if (chainTail[home] == next)
+                chainTail[home] = j;
+            table[next] = Student();
+            markFree(next);
+        } else {
+            if (prev != -1)
+                table[prev].link = table[j].link;
+            if (table[j].link != -1)
+                prevSlot[table[j].link] = prev;
+            if (chainTail[home] == j)
+                chainTail[home] = prev;
+            table[j] = Student();
+            markFree(j);
+        }
+        return true;
+    }
+
+    // Write the slot array (links included) to a flat file that MappedHashTable can open
+    bool save(const char* path) {
+        ofstream file(path, ios::binary | ios::trunc);
+        if (!file)
+            return false;
+        SnapshotHeader header;
+        memcpy(header.magic, SNAPSHOT_MAGIC, sizeof(header.magic));
+        header.slotSize = (int)sizeof(Student);
+        header.size = (int)table.size();
+        file.write((char*)&header, sizeof(header));
+        file.write((char*)table.data(), sizeof(Student) * table.size());
+        return (bool)file;
     }
 
     void display() {
         cout << "\nIndex\tPNR\tMarks\tLink\n";
-        for (int i = 0; i < SIZE; ++i) {
+        for (int i = 0; i < (int)table.size(); ++i) {
             if (table[i].occupied)
                 cout << i << "\t" << table[i].pnr << "\t" << table[i].marks << "\t" << table[i].link << endl;
             else
@@ -96,7 +234,170 @@ public:
     }
 };
 
-int main() {
+// Read-only view of a saved table. The file is mapped into memory and the slots are used in
+// place, so opening costs the same for any table size; pages are read in as lookups touch them.
+class MappedHashTable {
+    void* data = MAP_FAILED;
+    size_t length = 0;
+    const Student* table = nullptr;
+    int size = 0;
+
+    int hashFunction(int pnr) const {
+        return pnr % size;
+    }
+
+public:
+    MappedHashTable(const char* path) {
+        int fd = open(path, O_RDONLY);
+        if (fd == -1)
+            return;
+        struct stat st;
+        if (fstat(fd, &st) == 0 && (size_t)st.st_size >= sizeof(SnapshotHeader)) {
+            length = (size_t)st.st_size;
+            data = mmap(nullptr, length, PROT_READ, MAP_SHARED, fd, 0);
+        }
+        close(fd);
+        if (data == MAP_FAILED)
+            return;
+
+        const SnapshotHeader* header = (const SnapshotHeader*)data;
+        if (memcmp(header->magic, SNAPSHOT_MAGIC, sizeof(header->magic)) != 0
+            || header->slotSize != (int)sizeof(Student) || header->size <= 0
+            || length < sizeof(SnapshotHeader) + sizeof(Student) * (size_t)header->size) {
+            cout << "Not a valid snapshot: " << path << "\n";
+            return;
+        }
+        size = header->size;
+        table = (const Student*)((const char*)data + sizeof(SnapshotHeader));
+    }
+
+    MappedHashTable(const MappedHashTable&) = delete;
+    MappedHashTable& operator=(const MappedHashTable&) = delete;
+
+    ~MappedHashTable() {
+        if (data != MAP_FAILED)
+            munmap(data, length);
+    }
+
+    bool isOpen() const { return table != nullptr; }
+
+    bool search(int pnr, int& marks) const {
+        int j = hashFunction(pnr);
+        if (!table[j].occupied || hashFunction(table[j].pnr) != j)
+            return false;
+
+        // Links come from the file, so each is checked before it is followed; a chain visits
+        // each slot at most once, so more steps than slots means a link cycle
+        for (int steps = 0; j != -1 && steps < size; ++steps) {
+            if (j < 0 || j >= size)
+                return false;
+            if (table[j].pnr == pnr) {
+                marks = table[j].marks;
+                return true;
+            }
+            j = table[j].link;
+        }
+        return false;
+    }
+};
+
+// Average lookup latency for stored (hit) and absent (miss) PNRs at 80% load
+void benchmark(int size) {
+    int n = size * 8 / 10;
+    vector<int> keys(2 * n);
+    for (int i = 0; i < 2 * n; ++i)
+        keys[i] = 100000 + i;
+    shuffle(keys.begin(), keys.end(), mt19937(42));
+
+    HashTable ht(size);
+    for (int i = 0; i < n; ++i)
+        ht.insert(keys[i], i % 100);
+
+    int marks;
+    long long found = 0;
+    auto t0 = chrono::steady_clock::now();
+    for (int i = 0; i < n; ++i)
+        found += ht.search(keys[i], marks);
+    auto t1 = chrono::steady_clock::now();
+    for (int i = n; i < 2 * n; ++i)
+        found += ht.search(keys[i], marks);
+    auto t2 = chrono::steady_clock::now();
+
+    cout << "\nBenchmark (with replacement), size " << size << ", " << n << " records:\n";
+    cout << "Hit:  " << chrono::duration<double, nano>(t1 - t0).count() / n << " ns/lookup\n";
+    cout << "Miss: " << chrono::duration<double, nano>(t2 - t1).count() / n << " ns/lookup\n";
+    cout << "Found: " << found << "\n";
+}
+
+// Insert cost while filling a table to 95% load with random PNRs, then one insert past full
+void loadBenchmark(int size) {
+    int n = (int)(size * 0.95);
+    mt19937 rng(42);
+    vector<int> keys;
+    while ((int)keys.size() < n) {
+        while ((int)keys.size() < n)
+            keys.push_back((int)(rng() >> 1));
+        sort(keys.begin(), keys.end());
+        keys.erase(unique(keys.begin(), keys.end()), keys.end());
+    }
+    shuffle(keys.begin(), keys.end(), rng);
+
+    HashTable ht(size);
+    int last = n - size * 5 / 100;   // the inserts from 90% to 95% load
+    auto t0 = chrono::steady_clock::now();
+    for (int i = 0; i < last; ++i)
+        ht.insert(keys[i], i % 100);
+    auto t1 = chrono::steady_clock::now();
+    for (int i = last; i < n; ++i)
+        ht.insert(keys[i], i % 100);
+    auto t2 = chrono::steady_clock::now();
+
+    int marks, missing = 0;
+    for (int i = 0; i < n; ++i)
+        if (!ht.search(keys[i], marks) || marks != i % 100)
+            ++missing;
+
+    cout << "\nFilling size " << size << " to 95% load:\n";
+    cout << "Inserts up to 90%: " << chrono::duration<double, nano>(t1 - t0).count() / last << " ns/insert\n";
+    cout << "Inserts 90% to 95%: " << chrono::duration<double, nano>(t2 - t1).count() / (n - last) << " ns/insert\n";
+    cout << "Lookups failed: " << missing << "\n";
+
+    HashTable small(4);
+    for (int pnr = 1; pnr <= 4; ++pnr)
+        small.insert(pnr, pnr);
+    bool inserted = small.insert(5, 5);
+    cout << "Insert into a full table returned " << (inserted ? "true" : "false") << "\n";
+}
+
+// Save a table of n records, then time reopening it through the mapping
+void snapshotBenchmark(int n) {
+    vector<pair<int, int>> records(n);
+    for (int i = 0; i < n; ++i)
+        records[i] = {100000 + i * 7, i % 100};
+
+    HashTable ht((int)(n / 0.8) + 1);
+    for (const pair<int, int>& r : records)
+        ht.insert(r.first, r.second);
+    auto t0 = chrono::steady_clock::now();
+    ht.save(SNAPSHOT_FILE);
+    auto t1 = chrono::steady_clock::now();
+    MappedHashTable mapped(SNAPSHOT_FILE);
+    int marks, missing = mapped.isOpen() ? 0 : n;
+    bool first = mapped.isOpen() && mapped.search(records[0].first, marks);
+    auto t2 = chrono::steady_clock::now();
+    for (int i = 0; mapped.isOpen() && i < n; ++i)
+        if (!mapped.search(records[i].first, marks) || marks != records[i].second)
+            ++missing;
+    auto t3 = chrono::steady_clock::now();
+
+    cout << "\nSnapshot of " << n << " records:\n";
+    cout << "Save: " << chrono::duration<double, milli>(t1 - t0).count() << " ms\n";
+    cout << "Open + first lookup: " << chrono::duration<double, milli>(t2 - t1).count() << " ms"
+         << (first ? "" : " (lookup failed)") << "\n";
+    cout << "All lookups: " << chrono::duration<double, milli>(t3 - t2).count() << " ms, failed: " << missing << "\n";
+}
+
+int main(int argc, char* argv[]) {
     HashTable ht;
     int pnrList[] = {11, 21, 31, 34, 55, 52, 33};
     int marksList[] = {70, 80, 75, 85, 90, 60, 65};
@@ -106,6 +407,29 @@ int main() {
 
     ht.display();
 
+    int marks;
+    if (ht.search(31, marks))
+        cout << "\nPNR 31 found with marks " << marks << "\n";
+    if (!ht.search(41, marks))
+        cout << "PNR 41 not found\n";
+
+    ht.remove(11);
+    cout << "\nAfter deleting 11:";
+    ht.display();
+
+    // Save the table and reopen it without rebuilding
+    if (ht.save(SNAPSHOT_FILE)) {
+        MappedHashTable mapped(SNAPSHOT_FILE);
+        if (mapped.isOpen() && mapped.search(31, marks))
+            cout << "\nPNR 31 found in snapshot with marks " << marks << "\n";
+    }
+
+    if (argc > 1) {
+        benchmark(atoi(argv[1]));
+        loadBenchmark(atoi(argv[1]));
+        snapshotBenchmark(argc > 2 ? atoi(argv[2]) : 1000000);
+    }
+
     return 0;
 }
 
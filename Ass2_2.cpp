@@ -0,0 +1,385 @@
+// Input a list of more than 20 correctly spelled lowercase words. The words are inserted into the
+// hash table. Handle collision using separate chaining. After input is obtained, each word that the
+// user enters into the program is looked up within the hash table to see if it exists. If the user
+// entered word exists within the hash table, then that word is spelled correctly.
+// Perfect hash version: the dictionary never changes after it is built, so instead of chains
+// every word gets a slot of its own. Words are grouped into buckets by one hash; each bucket
+// stores a displacement, a seed for a second hash that sends all of its words to free slots
+// (hash and displace, as in CHD). A lookup is two hashes, one displacement and one word compare.
+// For the built-in words the table is computed by the compiler (constexpr); a word file is
+// turned into one when the program starts.
+// Usage: ./a.out [word-file [text-file]]
+
+#include<iostream>
+#include<vector>
+#include<list>
+#include<string>
+#include<array>
+#include<chrono>
+#include<cstdint>
+#include<cstring>
+#include<algorithm>
+#include<random>
+#include<fstream>
+
+using namespace std;
+
+const int TABLE_SIZE = 10;
+
+// FNV-1a with a seed, then a murmur3 finish so every output bit depends on every byte.
+// constexpr so the same function places words at compile time and at run time.
+constexpr uint64_t hashFunction(const char* p, size_t n, uint64_t seed){
+    uint64_t hash = 0xcbf29ce484222325ULL ^ (seed * 0x9e3779b97f4a7c15ULL);
+    for(size_t i = 0; i < n; ++i){
+        hash = (hash ^ (unsigned char)p[i]) * 0x100000001b3ULL;
+    }
+    hash ^= hash >> 33;
+    hash *= 0xff51afd7ed558ccdULL;
+    hash ^= hash >> 33;
+    hash *= 0xc4ceb9fe1a85ec53ULL;
+    hash ^= hash >> 33;
+    return hash;
+}
+
+constexpr size_t length(const char* p){
+    size_t n = 0;
+    while(p[n] != '\0'){
+        ++n;
+    }
+    return n;
+}
+
+constexpr bool sameWord(const char* a, const char* b, size_t n){
+    for(size_t i = 0; i < n; ++i){
+        if(a[i] != b[i]){
+            return false;
+        }
+    }
+    return a[n] == '\0';
+}
+
+// Perfect hash over N fixed words, built by the compiler. displacement[b] >= 0 is the seed
+// for the words of bucket b; -(s + 1) means bucket b holds one word, stored in slot s.
+template<size_t N>
+struct StaticDictionary{
+    array<const char*, N> words{};      // words[s] is the word in slot s
+    array<int32_t, N> displacement{};
+
+    static constexpr size_t bucketOf(const char* p, size_t n){
+        return hashFunction(p, n, 0) % N;
+    }
+
+    constexpr bool search(const char* p, size_t n) const {
+        int32_t d = displacement[bucketOf(p, n)];
+        size_t slot = d < 0 ? (size_t)(-d - 1) : hashFunction(p, n, (uint64_t)d) % N;
+        return sameWord(words[slot], p, n);
+    }
+
+    bool search(const string& word) const { return search(word.data(), word.size()); }
+};
+
+template<size_t N>
+constexpr StaticDictionary<N> makeStaticDictionary(const array<const char*, N>& input){
+    StaticDictionary<N> dict{};
+    array<size_t, N> bucket{};
+    array<size_t, N> bucketSize{};
+    for(size_t i = 0; i < N; ++i){
+        bucket[i] = StaticDictionary<N>::bucketOf(input[i], length(input[i]));
+        ++bucketSize[bucket[i]];
+    }
+
+    // Buckets largest first: the big ones are placed while most slots are still free
+    array<size_t, N> order{};
+    for(size_t b = 0; b < N; ++b){
+        order[b] = b;
+    }
+    for(size_t i = 1; i < N; ++i){
+        for(size_t j = i; j > 0 && bucketSize[order[j]] > bucketSize[order[j - 1]]; --j){
+            size_t t = order[j];
+            order[j] = order[j - 1];
+            order[j - 1] = t;
+        }
+    }
+
+    array<bool, N> taken{};
+    for(size_t k = 0; k < N && bucketSize[order[k]] > 1; ++k){
+        size_t b = order[k];
+        for(int32_t d = 1;; ++d){
+            array<size_t, N> slots{};
+            size_t count = 0;
+            bool fits = true;
+            for(size_t i = 0; i < N && fits; ++i){
+                if(bucket[i] != b){
+                    continue;
+                }
+                size_t s = hashFunction(input[i], length(input[i]), (uint64_t)d) % N;
+                fits = !taken[s];
+                for(size_t j = 0; j < count && fits; ++j){
+                    fits = slots[j] != s;
+                }
+                slots[count++] = s;
+            }
+            if(!fits){
+                continue;
+            }
+            count = 0;
+            for(size_t i = 0; i < N; ++i){
+                if(bucket[i] == b){
+                    taken[slots[count]] = true;
+                    dict.words[slots[count++]] = input[i];
+                }
+            }
+            dict.displacement[b] = d;
+            break;
+        }
+    }
+
+    // Single words go straight to the remaining free slots
+    size_t free = 0;
+    for(size_t i = 0; i < N; ++i){
+        if(bucketSize[bucket[i]] != 1){
+            continue;
+        }
+        while(taken[free]){
+            ++free;
+        }
+        taken[free] = true;
+        dict.words[free] = input[i];
+        dict.displacement[bucket[i]] = -(int32_t)free - 1;
+    }
+    return dict;
+}
+
+constexpr array<const char*, 25> BUILTIN_WORDS = {
+    "apple", "banana", "grape", "orange", "melon",
+    "lemon", "cherry", "peach", "plum", "kiwi",
+    "mango", "pear", "lime", "apricot", "fig",
+    "date", "guava", "papaya", "coconut", "berry",
+    "nectarine", "lychee", "tangerine", "quince", "dragonfruit"
+};
+
+constexpr StaticDictionary<25> BUILTIN_DICTIONARY = makeStaticDictionary(BUILTIN_WORDS);
+
+constexpr bool findsAll(const StaticDictionary<25>& dict, const array<const char*, 25>& words){
+    for(const char* w: words){
+        if(!dict.search(w, length(w))){
+            return false;
+        }
+    }
+    return true;
+}
+
+static_assert(findsAll(BUILTIN_DICTIONARY, BUILTIN_WORDS), "built-in word missing");
+static_assert(!BUILTIN_DICTIONARY.search("aple", 4), "misspelling accepted");
+
+// The same scheme over a word file, built at run time. Words are stored back to back in one
+// arena; slot s holds the offset and length of its word.
+class PerfectHashTable{
+    struct Slot{
+        uint32_t offset;
+        uint32_t length;
+    };
+
+    vector<char> arena;
+    vector<Slot> slots;
+    vector<int32_t> displacement;   // one per bucket, meaning as in StaticDictionary
+    size_t buckets = 0;
+
+    static const int WORDS_PER_BUCKET = 4;
+
+public:
+    // Duplicate words are dropped; every other word gets exactly one slot
+    void build(vector<string> words){
+        sort(words.begin(), words.end());
+        words.erase(unique(words.begin(), words.end()), words.end());
+        size_t n = words.size();
+        buckets = max((size_t)1, n / WORDS_PER_BUCKET);
+        slots.assign(n, Slot{0, 0});
+        displacement.assign(buckets, 0);
+        arena.clear();
+        if(n == 0){
+            return;
+        }
+
+        // Word numbers grouped by bucket: bucket b is members[first[b], first[b + 1])
+        vector<uint32_t> first(buckets + 1, 0), members(n);
+        vector<size_t> bucketOf(n);
+        for(size_t i = 0; i < n; ++i){
+            bucketOf[i] = hashFunction(words[i].data(), words[i].size(), 0) % buckets;
+            ++first[bucketOf[i] + 1];
+        }
+        for(size_t b = 0; b < buckets; ++b){
+            first[b + 1] += first[b];
+        }
+        vector<uint32_t> next(first.begin(), first.end() - 1);
+        for(size_t i = 0; i < n; ++i){
+            members[next[bucketOf[i]]++] = (uint32_t)i;
+        }
+
+        vector<uint32_t> order(buckets);
+        for(size_t b = 0; b < buckets; ++b){
+            order[b] = (uint32_t)b;
+        }
+        stable_sort(order.begin(), order.end(), [&](uint32_t a, uint32_t b){
+            return first[a + 1] - first[a] > first[b + 1] - first[b];
+        });
+
+        vector<bool> taken(n, false);
+        vector<size_t> chosen;
+        vector<size_t> placement(n);
+        size_t free = 0;
+        for(uint32_t b: order){
+            uint32_t size = first[b + 1] - first[b];
+            if(size == 0){
+                break;
+            }
+            if(size == 1){
+                while(taken[free]){
+                    ++free;
+                }
+                taken[free] = true;
+                placement[members[first[b]]] = free;
+                displacement[b] = -(int32_t)free - 1;
+                continue;
+            }
+            for(int32_t d = 1;; ++d){
+                chosen.clear();
+                bool fits = true;
+                for(uint32_t k = first[b]; k < first[b + 1] && fits; ++k){
+                    const string& w = words[members[k]];
+                    size_t s = hashFunction(w.data(), w.size(), (uint64_t)d) % n;
+                    fits = !taken[s] && find(chosen.begin(), chosen.end(), s) == chosen.end();
+                    chosen.push_back(s);
+                }
+                if(!fits){
+                    continue;
+                }
+                for(uint32_t k = first[b]; k < first[b + 1]; ++k){
+                    taken[chosen[k - first[b]]] = true;
+                    placement[members[k]] = chosen[k - first[b]];
+                }
+                displacement[b] = d;
+                break;
+            }
+        }
+
+        for(size_t i = 0; i < n; ++i){
+            slots[placement[i]] = Slot{(uint32_t)arena.size(), (uint32_t)words[i].size()};
+            arena.insert(arena.end(), words[i].begin(), words[i].end());
+        }
+    }
+
+    bool search(const string& word) const {
+        if(slots.empty()){
+            return false;
+        }
+        int32_t d = displacement[hashFunction(word.data(), word.size(), 0) % buckets];
+        size_t s = d < 0 ? (size_t)(-d - 1) : hashFunction(word.data(), word.size(), (uint64_t)d) % slots.size();
+        return slots[s].length == word.size()
+               && memcmp(&arena[slots[s].offset], word.data(), word.size()) == 0;
+    }
+
+    size_t size() const { return slots.size(); }
+
+    size_t bytes() const {
+        return arena.size() + slots.size() * sizeof(Slot) + displacement.size() * sizeof(int32_t);
+    }
+};
+
+// Separate chaining as in Ass2.cpp, for comparison
+class HashTable{
+    vector<list<string>> table;
+
+    size_t hashFunction(const string& word) const {
+        return ::hashFunction(word.data(), word.size(), 0) % table.size();
+    }
+
+public:
+    HashTable(size_t size = TABLE_SIZE){
+        table.resize(max(size, (size_t)1));
+    }
+
+    void insert(const string& word){
+        table[hashFunction(word)].push_back(word);
+    }
+
+    bool search(const string& word) const {
+        for(const string& w: table[hashFunction(word)]){
+            if(w == word){
+                return true;
+            }
+        }
+        return false;
+    }
+};
+
+vector<string> readWords(const string& path){
+    vector<string> words;
+    ifstream file(path);
+    string word;
+    while(file >> word){
+        words.push_back(word);
+    }
+    return words;
+}
+
+template<class Table>
+void benchmark(const string& name, const Table& table, const vector<string>& queries){
+    auto start = chrono::steady_clock::now();
+    size_t found = 0;
+    for(const string& q: queries){
+        found += table.search(q);
+    }
+    double ns = chrono::duration<double, nano>(chrono::steady_clock::now() - start).count();
+    cout << name << "\t" << ns / queries.size() << " ns/word (" << found << " found)\n";
+}
+
+int main(int argc, char* argv[]){
+    PerfectHashTable perfect;
+    bool fromFile = argc > 1;
+
+    if(fromFile){
+        vector<string> words = readWords(argv[1]);
+        auto start = chrono::steady_clock::now();
+        perfect.build(words);
+        double ms = chrono::duration<double, milli>(chrono::steady_clock::now() - start).count();
+        cout << "Perfect hash over " << perfect.size() << " words from " << argv[1] << " built in "
+             << ms << " ms, " << (double)perfect.bytes() / perfect.size() << " bytes per word.\n";
+
+        HashTable chained(words.size());
+        for(const string& w: words){
+            chained.insert(w);
+        }
+
+        // Queries: the text file if given, else the dictionary with every other word misspelled
+        vector<string> queries = argc > 2 ? readWords(argv[2]) : words;
+        if(argc <= 2){
+            for(size_t i = 0; i < queries.size(); i += 2){
+                queries[i].back() = queries[i].back() == 'q' ? 'z' : 'q';
+            }
+        }
+        shuffle(queries.begin(), queries.end(), mt19937(42));
+        benchmark("Perfect hash", perfect, queries);
+        benchmark("Chained\t", chained, queries);
+    } else {
+        cout << "Dictionary loaded with " << BUILTIN_WORDS.size() << " words (perfect hash computed at compile time).\n";
+    }
+
+    string input;
+    cout << "\nEnter words to check spelling (type 'exit' to stop):\n";
+
+    while(true){
+        cout << "> ";
+
+        if(!(cin>>input) || input == "exit"){
+            break;
+        }
+        bool found = fromFile ? perfect.search(input) : BUILTIN_DICTIONARY.search(input);
+        if(found){
+            cout << input << " is spelled correctly.\n";
+        } else {
+            cout << input << " is not found in the dictionary.\n";
+        }
+    }
+    return 0;
+}
@@ -0,0 +1,371 @@
+// Input a list of more than 20 correctly spelled lowercase words. The words are inserted into the
+// hash table. Handle collision using separate chaining. After input is obtained, each word that the
+// user enters into the program is looked up within the hash table to see if it exists. If the user
+// entered word exists within the hash table, then that word is spelled correctly.
+// Trie version: words are stored as paths of characters, so words sharing a prefix share its
+// nodes and every word starting with a prefix can be listed (autocomplete). Each node keeps its
+// first child and next sibling, children sorted by character. compact() then merges identical
+// subtrees, turning the trie into a DAWG: common endings such as "-ing" are stored once too.
+// Same insert/search interface as the HashTable in Ass2.cpp, plus startsWith(prefix).
+// Usage: ./a.out [word-file [text-file]]
+// Typing a word ending in '*' lists the dictionary words that start with it.
+
+#include<iostream>
+#include<vector>
+#include<list>
+#include<string>
+#include<chrono>
+#include<cstdint>
+#include<cstring>
+#include<algorithm>
+#include<unordered_map>
+#include<random>
+#include<fstream>
+#include<malloc.h>
+
+using namespace std;
+
+const int TABLE_SIZE = 10;
+
+const vector<string> BUILTIN_WORDS = {
+    "apple", "banana", "grape", "orange", "melon",
+    "lemon", "cherry", "peach", "plum", "kiwi",
+    "mango", "pear", "lime", "apricot", "fig",
+    "date", "guava", "papaya", "coconut", "berry",
+    "nectarine", "lychee", "tangerine", "quince", "dragonfruit"
+};
+
+class Trie{
+    // Node 0 is the root. A node is the edge labelled label into it; terminal marks the end
+    // of a word. -1 is used for no child / no sibling.
+    struct Node{
+        int32_t child;
+        int32_t sibling;
+        char label;
+        bool terminal;
+    };
+
+    vector<Node> nodes;
+    size_t count = 0;
+    bool compacted = false;
+
+    // Child of node with the given label, or -1
+    int32_t findChild(int32_t node, char label) const {
+        int32_t c = nodes[node].child;
+        while(c != -1 && nodes[c].label < label){
+            c = nodes[c].sibling;
+        }
+        return c != -1 && nodes[c].label == label ? c : -1;
+    }
+
+    // Node reached by following prefix from the root, or -1
+    int32_t walk(const string& prefix) const {
+        int32_t node = 0;
+        for(size_t i = 0; i < prefix.size() && node != -1; ++i){
+            node = findChild(node, prefix[i]);
+        }
+        return node;
+    }
+
+    template<class F>
+    bool enumerate(int32_t node, string& word, F& f) const {
+        for(int32_t c = nodes[node].child; c != -1; c = nodes[c].sibling){
+            word.push_back(nodes[c].label);
+            if(nodes[c].terminal && !f(word)){
+                return false;
+            }
+            if(!enumerate(c, word, f)){
+                return false;
+            }
+            word.pop_back();
+        }
+        return true;
+    }
+
+    // Key of a node for merging: two nodes with the same label, end flag, children and
+    // following siblings accept the same strings and can be one node
+    struct Signature{
+        int32_t child;
+        int32_t sibling;
+        char label;
+        bool terminal;
+
+        bool operator==(const Signature& o) const {
+            return child == o.child && sibling == o.sibling && label == o.label && terminal == o.terminal;
+        }
+    };
+
+    struct SignatureHash{
+        size_t operator()(const Signature& s) const {
+            uint64_t h = (uint64_t)(uint32_t)s.child * 0x9e3779b97f4a7c15ULL;
+            h ^= (uint64_t)(uint32_t)s.sibling * 0xc2b2ae3d27d4eb4fULL;
+            h ^= (uint64_t)(unsigned char)s.label << 1 | s.terminal;
+            h ^= h >> 29;
+            return (size_t)h;
+        }
+    };
+
+    // Merged copy of node into out, returning its index there; children first, so equal
+    // subtrees are already single nodes when their parents are compared
+    int32_t merge(int32_t node, vector<Node>& out, unordered_map<Signature, int32_t, SignatureHash>& seen) const {
+        if(node == -1){
+            return -1;
+        }
+        const Node& n = nodes[node];
+        Signature s{merge(n.child, out, seen), merge(n.sibling, out, seen), n.label, n.terminal};
+        auto it = seen.find(s);
+        if(it != seen.end()){
+            return it->second;
+        }
+        out.push_back(Node{s.child, s.sibling, s.label, s.terminal});
+        seen.emplace(s, (int32_t)out.size() - 1);
+        return (int32_t)out.size() - 1;
+    }
+
+public:
+    Trie(){
+        nodes.push_back(Node{-1, -1, 0, false});
+    }
+
+    void insert(const string& word){
+        if(compacted){
+            // Shared nodes cannot be extended in place: go back to a plain trie first
+            vector<string> words = startsWith("");
+            nodes.assign(1, Node{-1, -1, 0, false});
+            count = 0;
+            compacted = false;
+            for(const string& w: words){
+                insert(w);
+            }
+        }
+
+        int32_t node = 0;
+        for(char ch: word){
+            // Keep the children sorted: find the sibling to insert after
+            int32_t prev = -1, c = nodes[node].child;
+            while(c != -1 && nodes[c].label < ch){
+                prev = c;
+                c = nodes[c].sibling;
+            }
+            if(c == -1 || nodes[c].label != ch){
+                nodes.push_back(Node{-1, c, ch, false});
+                int32_t added = (int32_t)nodes.size() - 1;
+                if(prev == -1){
+                    nodes[node].child = added;
+                } else {
+                    nodes[prev].sibling = added;
+                }
+                c = added;
+            }
+            node = c;
+        }
+        if(!nodes[node].terminal){
+            nodes[node].terminal = true;
+            ++count;
+        }
+    }
+
+    bool search(const string& word) const {
+        int32_t node = walk(word);
+        return node != -1 && nodes[node].terminal;
+    }
+
+    // Calls f(word) for every word starting with prefix, in alphabetical order, until f
+    // returns false
+    template<class F>
+    void forEachWithPrefix(const string& prefix, F f) const {
+        int32_t node = walk(prefix);
+        if(node == -1){
+            return;
+        }
+        string word = prefix;
+        if(nodes[node].terminal && !f(word)){
+            return;
+        }
+        enumerate(node, word, f);
+    }
+
+    vector<string> startsWith(const string& prefix, size_t limit = SIZE_MAX) const {
+        vector<string> words;
+        if(limit > 0){
+            forEachWithPrefix(prefix, [&](const string& w){
+                words.push_back(w);
+                return words.size() < limit;
+            });
+        }
+        return words;
+    }
+
+    // Merge identical subtrees (trie -> DAWG). Searches and startsWith work the same.
+    void compact(){
+        vector<Node> out;
+        unordered_map<Signature, int32_t, SignatureHash> seen;
+        out.push_back(Node{-1, -1, 0, nodes[0].terminal});
+        out[0].child = merge(nodes[0].child, out, seen);
+        nodes.swap(out);
+        nodes.shrink_to_fit();
+        compacted = true;
+    }
+
+    size_t size() const { return count; }
+
+    size_t nodeCount() const { return nodes.size(); }
+
+    // Allocated, not just used, so it compares with the heap measured for the hash table
+    size_t bytes() const { return nodes.capacity() * sizeof(Node); }
+
+    void loadDictionary() {
+        for (const string& word : BUILTIN_WORDS) {
+            insert(word);
+        }
+
+        cout << "Dictionary loaded with " << BUILTIN_WORDS.size() << " words.\n";
+    }
+};
+
+// Baseline for comparison: the plain separate-chaining table of the original assignment, with
+// its *31 polynomial hash. It is not the tuned table of Ass2.cpp (wyhash-style hashWord).
+class HashTable{
+    vector<list<string>> table;
+
+    size_t hashFunction(const string& word) const {
+        uint64_t hash = 0;
+        for(char ch: word){
+            hash = hash*31 + (unsigned char)ch;
+        }
+        return hash % table.size();
+    }
+
+public:
+    HashTable(size_t size = TABLE_SIZE){
+        table.resize(max(size, (size_t)1));
+    }
+
+    void insert(const string& word){
+        table[hashFunction(word)].push_back(word);
+    }
+
+    bool search(const string& word) const {
+        for(const string& w: table[hashFunction(word)]){
+            if(w == word){
+                return true;
+            }
+        }
+        return false;
+    }
+};
+
+vector<string> readWords(const string& path){
+    vector<string> words;
+    ifstream file(path);
+    string word;
+    while(file >> word){
+        words.push_back(word);
+    }
+    return words;
+}
+
+// Heap in use, counting blocks big enough to get their own mapping (large vectors)
+size_t heapInUse(){
+    struct mallinfo2 info = mallinfo2();
+    return info.uordblks + info.hblkhd;
+}
+
+template<class Table>
+void lookupBenchmark(const string& name, const Table& table, const vector<string>& queries, size_t bytes){
+    auto start = chrono::steady_clock::now();
+    size_t found = 0;
+    for(const string& q: queries){
+        found += table.search(q);
+    }
+    double ns = chrono::duration<double, nano>(chrono::steady_clock::now() - start).count();
+    cout << name << "\t" << bytes / 1024 << " KB\t" << ns / queries.size() << " ns/word\t("
+         << found << " found)\n";
+}
+
+int main(int argc, char* argv[]){
+    Trie trie;
+
+    if(argc > 1){
+        vector<string> words = readWords(argv[1]);
+
+        size_t before = heapInUse();
+        HashTable chained(words.size());
+        for(const string& w: words){
+            chained.insert(w);
+        }
+        size_t chainedBytes = heapInUse() - before;
+
+        before = heapInUse();
+        auto start = chrono::steady_clock::now();
+        for(const string& w: words){
+            trie.insert(w);
+        }
+        auto built = chrono::steady_clock::now();
+        size_t trieNodes = trie.nodeCount(), trieBytes = heapInUse() - before;
+        before = heapInUse();
+        Trie dawg = trie;
+        dawg.compact();
+        auto compacted = chrono::steady_clock::now();
+        size_t dawgBytes = heapInUse() - before;
+        cout << trie.size() << " words from " << argv[1] << ": trie of " << trieNodes
+             << " nodes built in " << chrono::duration<double, milli>(built - start).count()
+             << " ms, compacted to " << dawg.nodeCount() << " DAWG nodes in "
+             << chrono::duration<double, milli>(compacted - built).count() << " ms.\n";
+
+        // Queries: the text file if given, else the dictionary with every other word misspelled
+        vector<string> queries = argc > 2 ? readWords(argv[2]) : words;
+        if(argc <= 2){
+            for(size_t i = 0; i < queries.size(); i += 2){
+                queries[i].back() = queries[i].back() == 'q' ? 'z' : 'q';
+            }
+        }
+        shuffle(queries.begin(), queries.end(), mt19937(42));
+        cout << "Table\t\tMemory\t\tLookup\n";
+        lookupBenchmark("Chained list", chained, queries, chainedBytes);
+        lookupBenchmark("Trie\t", trie, queries, trieBytes);
+        lookupBenchmark("DAWG\t", dawg, queries, dawgBytes);
+
+        // Autocomplete: first 10 completions of the first three letters of random words
+        mt19937 rng(7);
+        int prefixes = 10000;
+        size_t listed = 0;
+        auto t0 = chrono::steady_clock::now();
+        for(int i = 0; i < prefixes; ++i){
+            const string& w = words[rng() % words.size()];
+            listed += dawg.startsWith(w.substr(0, 3), 10).size();
+        }
+        double us = chrono::duration<double, micro>(chrono::steady_clock::now() - t0).count();
+        cout << "startsWith: " << us / prefixes << " us per 3-letter prefix (" << listed
+             << " completions listed, at most 10 each).\n";
+
+        trie = dawg;
+    } else {
+        trie.loadDictionary();
+    }
+
+    string input;
+    cout << "\nEnter words to check spelling, or a prefix ending in '*' (type 'exit' to stop):\n";
+
+    while(true){
+        cout << "> ";
+
+        if(!(cin>>input) || input == "exit"){
+            break;
+        }
+        if(input.back() == '*'){
+            input.pop_back();
+            vector<string> words = trie.startsWith(input, 20);
+            cout << words.size() << (words.size() == 20 ? "+" : "") << " words start with \"" << input << "\":";
+            for(const string& w: words){
+                cout << " " << w;
+            }
+            cout << "\n";
+        } else if(trie.search(input)){
+            cout << input << " is spelled correctly.\n";
+        } else {
+            cout << input << " is not found in the dictionary.\n";
+        }
+    }
+    return 0;
+}
@@ -1,14 +1,48 @@
 // Department maintains student information. the file contains rollno, name, division, and address.
 // Allow user to add, edit, delete, insert and search information of student. use Direct access file to
 // maintain the data. 
+// The record position is computed from the roll number: the file is a header followed by
+// buckets of SLOTS_PER_BUCKET records, and a student lives in bucket rollNo % bucketCount. A
+// bucket is read or written with one seek and one read/write. When a bucket is full, further
+// students go to overflow buckets appended after the primary area and chained from it.
+// Overflow buckets emptied by deletes are kept on a free list for reuse, and once the file is
+// 80% full it is rehashed into twice the buckets. The header records all of this and is
+// updated after the records it describes, in one of two checksummed copies.
+// Storage is either fstream (a seek and a read/write per bucket) or, with --mmap, the whole
+// file mapped into memory: buckets are copied to and from the mapping and msync commits.
+// A B+-tree index on roll number (StudentIndex.h) in students.dat.idx lists roll number
+// ranges in order without reading the whole file. Secondary indexes on name (hashed) and
+// division (sorted) find students by those without a scan. All three are kept up to date
+// on add, edit and delete, and rebuilt after the file grows.
+// Usage: ./a.out [--mmap]     interactive menu on students.dat
+//        ./a.out N            benchmark both storages: N records in students_bench.dat
 
 #include <iostream>
 #include <fstream>
 #include <cstring>
+#include <cstdio>
+#include <cstdlib>
+#include <chrono>
+#include <random>
+#include <vector>
+#include <algorithm>
+#include <string>
+#include <cstddef>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#include "StudentIndex.h"
 using namespace std;
 
-const int MAX = 100;
+const int INITIAL_RECORDS = 100;     // the file starts this big and doubles as it fills
 const char* FILENAME = "students.dat";
+const char* BENCH_FILENAME = "students_bench.dat";
+
+const int SLOTS_PER_BUCKET = 8;
+
+// Index files next to the student file: roll number, name, division
+const char* INDEX_SUFFIXES[3] = {".idx", ".name.idx", ".div.idx"};
 
 class Student {
 public:
@@ -43,165 +77,1052 @@ public:
     }
 };
 
-// Adds a student to the first empty slot
-void addStudent() {
-    fstream file(FILENAME, ios::in | ios::out | ios::binary);
-    Student s;
-    s.input();
-    Student temp;
-
-    for (int i = 0; i < MAX; ++i) {
-        file.seekg(i * sizeof(Student), ios::beg);
-        file.read((char*)&temp, sizeof(Student));
-        if (temp.rollNo == -1) {
-            file.seekp(i * sizeof(Student), ios::beg);
-            file.write((char*)&s, sizeof(Student));
-            cout << "Student added successfully.\n";
+// Unit of file I/O: a bucket of records plus the overflow bucket chained after it
+struct Bucket {
+    Student slots[SLOTS_PER_BUCKET];
+    int overflow;   // bucket number of the next overflow bucket, -1 if none
+
+    Bucket() { overflow = -1; }
+};
+
+// Two copies of the header sit at the start of the file. Each update goes to the copy not
+// holding the newest sequence number, so a write torn by a crash leaves the other one intact;
+// open() takes the valid copy with the higher sequence.
+struct FileHeader {
+    char magic[8];
+    unsigned sequence;
+    int bucketCount;    // primary buckets; overflow buckets are numbered from here on
+    int overflowCount;  // overflow buckets ever allocated
+    int freeOverflow;   // first bucket of the free list of emptied overflow buckets, -1 if none
+    int records;
+    unsigned checksum;  // of the fields above
+};
+
+const char FILE_MAGIC[8] = "STUHSH2";
+const double MAX_LOAD = 0.8;     // records per slot before the file doubles its buckets
+
+// Where a record lives: bucket number and slot inside it
+struct Location {
+    int bucket;
+    int slot;
+};
+
+// Byte-level access to the student file through fstream: every bucket is a seek plus a read
+// or write system call
+class StreamStorage {
+    fstream file;
+    int fd = -1;            // second descriptor, only for fsync
+
+public:
+    ~StreamStorage() { close(); }
+
+    bool open(const char* path, bool truncate) {
+        file.open(path, truncate ? ios::in | ios::out | ios::binary | ios::trunc
+                                 : ios::in | ios::out | ios::binary);
+        if (!file)
+            return false;
+        fd = ::open(path, O_RDONLY);
+        return true;
+    }
+
+    bool read(size_t offset, void* p, size_t n) {
+        file.seekg((streamoff)offset, ios::beg);
+        file.read((char*)p, (streamsize)n);
+        if (!file) {
+            file.clear();
+            return false;
+        }
+        return true;
+    }
+
+    bool write(size_t offset, const void* p, size_t n) {
+        file.seekp((streamoff)offset, ios::beg);
+        file.write((const char*)p, (streamsize)n);
+        if (!file) {
+            file.clear();
+            return false;
+        }
+        return true;
+    }
+
+    // Calls f(record) for count records of size bytes from offset on, read in order
+    template <class F>
+    void scan(size_t offset, size_t size, size_t count, F f) {
+        vector<char> buffer(size);
+        file.seekg((streamoff)offset, ios::beg);
+        for (size_t i = 0; i < count && file.read(buffer.data(), (streamsize)size); ++i)
+            f(buffer.data());
+        file.clear();
+    }
+
+    // Everything written so far reaches the disk before anything written after
+    void sync(bool durable) {
+        file.flush();
+        if (durable && fd != -1)
+            fsync(fd);
+    }
+
+    void close() {
+        if (file.is_open())
             file.close();
+        if (fd != -1)
+            ::close(fd);
+        fd = -1;
+    }
+};
+
+// The whole student file mapped into memory: a bucket read or write is a copy to or from
+// the mapping, with no system call. The file is extended (and remapped) in large steps as
+// buckets are added past its end, and msync makes the changes durable.
+class MappedStorage {
+    int fd = -1;
+    char* data = nullptr;
+    size_t length = 0;
+    size_t used = 0;        // bytes written; the mapping grows ahead of this
+
+    // False if the file could not be extended or remapped to end bytes
+    bool reserve(size_t end) {
+        if (end <= length)
+            return true;
+        size_t newLength = max(end, max(length * 2, (size_t)1 << 20));
+        if (ftruncate(fd, (off_t)newLength) != 0)
+            return false;
+        void* p = data ? mremap(data, length, newLength, MREMAP_MAYMOVE)
+                       : mmap(nullptr, newLength, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+        if (p == MAP_FAILED)
+            return false;
+        data = (char*)p;
+        length = newLength;
+        return true;
+    }
+
+public:
+    ~MappedStorage() { close(); }
+
+    bool open(const char* path, bool truncate) {
+        fd = ::open(path, O_RDWR | (truncate ? O_CREAT | O_TRUNC : 0), 0644);
+        if (fd == -1)
+            return false;
+        struct stat st;
+        if (fstat(fd, &st) == 0 && st.st_size > 0) {
+            void* p = mmap(nullptr, (size_t)st.st_size, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+            if (p == MAP_FAILED) {
+                ::close(fd);
+                fd = -1;
+                return false;
+            }
+            data = (char*)p;
+            length = used = (size_t)st.st_size;
+        }
+        return true;
+    }
+
+    bool read(size_t offset, void* p, size_t n) {
+        if (offset + n > used)
+            return false;
+        memcpy(p, data + offset, n);
+        return true;
+    }
+
+    bool write(size_t offset, const void* p, size_t n) {
+        if (!reserve(offset + n))
+            return false;
+        memcpy(data + offset, p, n);
+        used = max(used, offset + n);
+        return true;
+    }
+
+    // Hands out pointers straight into the mapping
+    template <class F>
+    void scan(size_t offset, size_t size, size_t count, F f) {
+        for (size_t i = 0; i < count && offset + (i + 1) * size <= used; ++i)
+            f(data + offset + i * size);
+    }
+
+    void sync(bool durable) {
+        if (durable && data)
+            msync(data, length, MS_SYNC);
+    }
+
+    // Drops the room reserved past the last write
+    void close() {
+        if (data)
+            munmap(data, length);
+        data = nullptr;
+        length = 0;
+        if (fd != -1) {
+            if (ftruncate(fd, (off_t)used) != 0)
+                cerr << "Could not trim the student file\n";
+            ::close(fd);
+        }
+        used = 0;
+        fd = -1;
+    }
+};
+
+// The hashed student file over either storage
+template <class Storage>
+class HashedFile {
+    Storage storage;
+    FileHeader header;
+    string path;
+    bool durable = true;
+    RollIndex index;        // roll number -> bucket * SLOTS_PER_BUCKET + slot, once opened
+    NameIndex names;        // (name hash, roll number) -> the same
+    DivisionIndex divisions;
+
+    size_t offsetOf(int bucket) const {
+        return 2 * sizeof(FileHeader) + (size_t)bucket * sizeof(Bucket);
+    }
+
+    int home(int rollNo) const {
+        return (int)((unsigned)rollNo % (unsigned)header.bucketCount);
+    }
+
+    static unsigned checksum(const FileHeader& h) {
+        const unsigned char* p = (const unsigned char*)&h;
+        unsigned sum = 2166136261u;
+        for (size_t i = 0; i < offsetof(FileHeader, checksum); ++i)
+            sum = (sum ^ p[i]) * 16777619u;
+        return sum;
+    }
+
+    void sync() {
+        storage.sync(durable);
+    }
+
+    void writeHeader() {
+        sync();
+        ++header.sequence;
+        header.checksum = checksum(header);
+        if (!storage.write((header.sequence % 2) * sizeof(FileHeader), &header, sizeof(header)))
+            failed = true;
+        ++writes;
+        sync();
+    }
+
+    // Emptied overflow bucket b, already unlinked from its chain, goes on the free list
+    void freeOverflowBucket(int b) {
+        Bucket empty;
+        empty.overflow = header.freeOverflow;
+        writeBucket(b, empty);
+        header.freeOverflow = b;
+    }
+
+    // Overflow bucket to put s in: the head of the free list, or a new one at the end. A
+    // bucket off the free list is taken off it durably before it is written, so a crash can
+    // leak it but never hand it out a second time. A new bucket is written before the header
+    // counts it, so a scan never reaches one that was not.
+    int allocateOverflowBucket(const Student& s) {
+        int b;
+        Bucket added;
+        added.slots[0] = s;
+        if (header.freeOverflow != -1) {
+            Bucket bucket;
+            b = header.freeOverflow;
+            if (!readBucket(b, bucket))
+                return -1;
+            header.freeOverflow = bucket.overflow;
+            writeHeader();
+            writeBucket(b, added);
+        } else {
+            b = header.bucketCount + header.overflowCount;
+            writeBucket(b, added);
+            sync();
+            ++header.overflowCount;
+            writeHeader();
+        }
+        return b;
+    }
+
+    // Changes with every header write and every grow, so a stale index never matches
+    uint64_t version() const {
+        return (uint64_t)header.bucketCount << 32 | header.sequence;
+    }
+
+    static int64_t locationKey(Location at) {
+        return (int64_t)at.bucket * SLOTS_PER_BUCKET + at.slot;
+    }
+
+    static Location locationOf(int64_t key) {
+        return Location{(int)(key / SLOTS_PER_BUCKET), (int)(key % SLOTS_PER_BUCKET)};
+    }
+
+    static DivisionKey divisionOf(char division, int rollNo) {
+        return divisionKey(string(1, division), rollNo);
+    }
+
+    void indexRecord(const Student& s, Location at) {
+        if (!index.isOpen())
+            return;
+        index.insert(s.rollNo, locationKey(at));
+        names.insert(nameKey(s.name, s.rollNo), locationKey(at));
+        divisions.insert(divisionOf(s.division, s.rollNo), locationKey(at));
+    }
+
+    void unindexRecord(const Student& s) {
+        if (!index.isOpen())
             return;
+        index.remove(s.rollNo);
+        names.remove(nameKey(s.name, s.rollNo));
+        divisions.remove(divisionOf(s.division, s.rollNo));
+    }
+
+    // Rehash into a new file with twice the buckets, then rename it over this one. Every
+    // record moves, so an open index is rebuilt.
+    void grow() {
+        string tmp = path + ".tmp";
+        bool indexed = index.isOpen();
+        HashedFile bigger;
+        // Filled without fsync; one sync before the rename makes it durable as a whole
+        if (!bigger.create(tmp.c_str(), (int)(header.bucketCount * 2 * SLOTS_PER_BUCKET * MAX_LOAD), false))
+            return;
+        forEach([&](const Student& s) { bigger.insert(s); });
+        bigger.durable = durable;
+        bigger.writeHeader();
+        bool written = !bigger.failed;
+        bigger.close();
+        if (!written) {
+            // Keep this file as it is; the next insert tries again
+            cout << "Cannot grow " << path << ": writing the new file failed\n";
+            ::remove(tmp.c_str());
+            return;
+        }
+        close();
+        if (rename(tmp.c_str(), path.c_str()) != 0)
+            cout << "Cannot replace " << path << " with the grown file\n";
+        open(path.c_str(), durable);
+        if (indexed)
+            openIndexes();
+        ++grows;
+    }
+
+public:
+    long long reads = 0;     // bucket/header reads and writes since opening
+    long long writes = 0;
+    int grows = 0;
+    bool failed = false;     // a write did not reach the file; no further changes are made
+
+    ~HashedFile() { close(); }
+
+    void close() {
+        if (index.isOpen()) {
+            // After a failed write the indexes may not match the file: leave them unstamped
+            uint64_t stamp = failed ? 0 : version();
+            index.setStamp(stamp);
+            names.setStamp(stamp);
+            divisions.setStamp(stamp);
+            index.close();
+            names.close();
+            divisions.close();
+        }
+        storage.close();
+    }
+
+    // Make every change so far durable, whatever the durable setting
+    void commit() {
+        storage.sync(true);
+    }
+
+    // Opens an existing hashed student file. durable = false skips fsync (benchmarks).
+    bool open(const char* name, bool durableWrites = true) {
+        close();
+        path = name;
+        durable = durableWrites;
+        failed = false;
+        if (!storage.open(name, false))
+            return false;
+        FileHeader copies[2];
+        bool readable = storage.read(0, copies, sizeof(copies));
+        bool found = false;
+        for (const FileHeader& h : copies) {
+            if (!readable || memcmp(h.magic, FILE_MAGIC, sizeof(h.magic)) != 0 || h.checksum != checksum(h)
+                || h.bucketCount <= 0)
+                continue;
+            if (!found || h.sequence > header.sequence)
+                header = h;
+            found = true;
+        }
+        if (!found) {
+            storage.close();
+            return false;
+        }
+        return true;
+    }
+
+    // Creates an empty file with room for about records students before it grows
+    bool create(const char* name, int records, bool durableWrites = true) {
+        close();
+        for (const char* suffix : INDEX_SUFFIXES)
+            ::remove((string(name) + suffix).c_str());
+        path = name;
+        durable = durableWrites;
+        failed = false;
+        if (!storage.open(name, true))
+            return false;
+        memset(&header, 0, sizeof(header));
+        memcpy(header.magic, FILE_MAGIC, sizeof(header.magic));
+        header.bucketCount = max(1, (int)(records / (SLOTS_PER_BUCKET * MAX_LOAD)) + 1);
+        header.freeOverflow = -1;
+        FileHeader copies[2] = {header, header};
+        copies[0].checksum = copies[1].checksum = checksum(header);
+        bool written = storage.write(0, copies, sizeof(copies));
+        Bucket empty;
+        for (int b = header.bucketCount - 1; b >= 0 && written; --b)
+            written = storage.write(offsetOf(b), &empty, sizeof(Bucket));
+        sync();
+        if (!written) {
+            storage.close();
+            return false;
         }
+        return true;
     }
 
-    cout << "File is full. Cannot add more students.\n";
-    file.close();
+    // False, with failed set, if the bucket cannot be read or links outside the overflow
+    // area; chain walks stop there instead of following a stale link
+    bool readBucket(int b, Bucket& bucket) {
+        ++reads;
+        if (!storage.read(offsetOf(b), &bucket, sizeof(Bucket))
+            || (bucket.overflow != -1 && (bucket.overflow < header.bucketCount
+                                          || bucket.overflow >= header.bucketCount + header.overflowCount))) {
+            failed = true;
+            return false;
+        }
+        return true;
+    }
+
+    void writeBucket(int b, const Bucket& bucket) {
+        if (!storage.write(offsetOf(b), &bucket, sizeof(Bucket)))
+            failed = true;
+        ++writes;
+    }
+
+    // Finds rollNo; on success bucket holds the bucket it was found in. False with failed
+    // set if the chain could not be read.
+    bool find(int rollNo, Bucket& bucket, Location& at) {
+        for (int b = home(rollNo); b != -1; b = bucket.overflow) {
+            if (!readBucket(b, bucket))
+                return false;
+            for (int i = 0; i < SLOTS_PER_BUCKET; ++i) {
+                if (bucket.slots[i].rollNo == rollNo) {
+                    at = {b, i};
+                    return true;
+                }
+            }
+        }
+        return false;
+    }
+
+    // Adds a student unless the roll number is already stored. The chain is read anyway
+    // to reject duplicates, so the first free slot seen on it is used.
+    bool insert(const Student& s) {
+        if (failed)
+            return false;
+        Bucket bucket;
+        Location free = {-1, -1};
+        int last = -1;
+        for (int b = home(s.rollNo); b != -1; b = bucket.overflow) {
+            if (!readBucket(b, bucket))
+                return false;
+            for (int i = 0; i < SLOTS_PER_BUCKET; ++i) {
+                if (bucket.slots[i].rollNo == s.rollNo)
+                    return false;
+                if (bucket.slots[i].rollNo == -1 && free.bucket == -1)
+                    free = {b, i};
+            }
+            last = b;
+        }
+
+        if (free.bucket == -1) {
+            // Chain full: allocate and fill an overflow bucket before linking it, so a crash
+            // in between leaves at worst an unreachable bucket
+            int b = allocateOverflowBucket(s);
+            if (failed)
+                return false;
+            sync();
+            bucket.overflow = b;
+            writeBucket(last, bucket);
+            free = {b, 0};
+        } else {
+            if (free.bucket != last && !readBucket(free.bucket, bucket))
+                return false;
+            bucket.slots[free.slot] = s;
+            writeBucket(free.bucket, bucket);
+        }
+        if (failed)
+            return false;
+        ++header.records;
+        writeHeader();
+        if (failed)
+            return false;
+        indexRecord(s, free);
+
+        if (header.records > header.bucketCount * SLOTS_PER_BUCKET * MAX_LOAD)
+            grow();
+        return true;
+    }
+
+    // Deletes rollNo. An overflow bucket left empty is unlinked and put on the free list.
+    bool remove(int rollNo) {
+        if (failed)
+            return false;
+        Bucket bucket, prev;
+        int prevBucket = -1;
+        for (int b = home(rollNo); b != -1; b = bucket.overflow) {
+            if (!readBucket(b, bucket))
+                return false;
+            for (int i = 0; i < SLOTS_PER_BUCKET; ++i) {
+                if (bucket.slots[i].rollNo != rollNo)
+                    continue;
+                Student removed = bucket.slots[i];
+                bucket.slots[i] = Student();
+                bool empty = true;
+                for (int j = 0; j < SLOTS_PER_BUCKET; ++j)
+                    empty = empty && bucket.slots[j].rollNo == -1;
+                if (empty && prevBucket != -1) {
+                    // Unlink before reusing it, so a crash in between leaks it instead of
+                    // leaving it on both the chain and the free list
+                    prev.overflow = bucket.overflow;
+                    writeBucket(prevBucket, prev);
+                    sync();
+                    if (!failed)
+                        freeOverflowBucket(b);
+                } else {
+                    writeBucket(b, bucket);
+                }
+                if (failed)
+                    return false;
+                --header.records;
+                writeHeader();
+                if (failed)
+                    return false;
+                unindexRecord(removed);
+                return true;
+            }
+            prev = bucket;
+            prevBucket = b;
+        }
+        return false;
+    }
+
+    // Overwrites the record with s's roll number where it stands
+    bool update(const Student& s) {
+        Bucket bucket;
+        Location at;
+        if (failed || !find(s.rollNo, bucket, at))
+            return false;
+        Student old = bucket.slots[at.slot];
+        bucket.slots[at.slot] = s;
+        writeBucket(at.bucket, bucket);
+        if (failed)
+            return false;
+        // The record count is unchanged, but the new sequence number changes version()
+        writeHeader();
+        if (failed)
+            return false;
+        unindexRecord(old);
+        indexRecord(s, at);
+        return true;
+    }
+
+    // Calls f(student, location) for every stored student, reading the file front to back
+    template <class F>
+    void forEachAt(F f) {
+        size_t total = header.bucketCount + header.overflowCount;
+        int b = 0;
+        storage.scan(offsetOf(0), sizeof(Bucket), total, [&](const void* p) {
+            const Bucket& bucket = *(const Bucket*)p;
+            ++reads;
+            for (int i = 0; i < SLOTS_PER_BUCKET; ++i)
+                if (bucket.slots[i].rollNo != -1)
+                    f(bucket.slots[i], Location{b, i});
+            ++b;
+        });
+    }
+
+    template <class F>
+    void forEach(F f) {
+        forEachAt([&](const Student& s, Location) { f(s); });
+    }
+
+    // Opens the roll number, name and division indexes, rebuilding all three from one scan
+    // if any is missing or does not match this version of the file. From then on inserts,
+    // updates and deletes keep them up to date.
+    bool openIndexes() {
+        if (index.open(path + INDEX_SUFFIXES[0], version()) && names.open(path + INDEX_SUFFIXES[1], version())
+            && divisions.open(path + INDEX_SUFFIXES[2], version()))
+            return true;
+        vector<pair<int32_t, int64_t>> byRoll;
+        vector<pair<NameKey, int64_t>> byName;
+        vector<pair<DivisionKey, int64_t>> byDivision;
+        byRoll.reserve(header.records);
+        byName.reserve(header.records);
+        byDivision.reserve(header.records);
+        forEachAt([&](const Student& s, Location at) {
+            byRoll.push_back({s.rollNo, locationKey(at)});
+            byName.push_back({nameKey(s.name, s.rollNo), locationKey(at)});
+            byDivision.push_back({divisionOf(s.division, s.rollNo), locationKey(at)});
+        });
+        return index.create(path + INDEX_SUFFIXES[0], byRoll, version())
+            && names.create(path + INDEX_SUFFIXES[1], byName, version())
+            && divisions.create(path + INDEX_SUFFIXES[2], byDivision, version());
+    }
+
+    // Where the students of a division are, in roll number order. Needs openIndexes().
+    vector<Location> findByDivision(char division) {
+        vector<Location> found;
+        divisions.range(divisionOf(division, INT32_MIN), divisionOf(division, INT32_MAX),
+                        [&](const DivisionKey&, int64_t location) { found.push_back(locationOf(location)); });
+        return found;
+    }
+
+    // Where the students with this name are. The index gives the records whose names share
+    // the hash; each is read to drop other names. Needs openIndexes().
+    vector<Location> findByName(const char* name) {
+        vector<Location> found;
+        uint32_t hash = nameHash(name);
+        Bucket bucket;
+        names.range(NameKey{hash, INT32_MIN}, NameKey{hash, INT32_MAX}, [&](const NameKey&, int64_t location) {
+            Location at = locationOf(location);
+            if (readBucket(at.bucket, bucket) && strcmp(bucket.slots[at.slot].name, name) == 0)
+                found.push_back(at);
+        });
+        return found;
+    }
+
+    // Calls f(student) for every roll number in [low, high], in increasing order. Needs
+    // openIndexes(); a bucket holding several of them in a row is read once.
+    template <class F>
+    void forEachInRange(int low, int high, F f) {
+        Bucket bucket;
+        int loaded = -1;
+        index.range(low, high, [&](int, int64_t location) {
+            int b = (int)(location / SLOTS_PER_BUCKET);
+            if (b != loaded) {
+                if (!readBucket(b, bucket))
+                    return;
+                loaded = b;
+            }
+            f(bucket.slots[location % SLOTS_PER_BUCKET]);
+        });
+    }
+
+    const RollIndex& rollIndex() const { return index; }
+    const NameIndex& nameIndex() const { return names; }
+    const DivisionIndex& divisionIndex() const { return divisions; }
+
+    int bucketCount() const { return header.bucketCount; }
+    int overflowCount() const { return header.overflowCount; }
+    int size() const { return header.records; }
+};
+
+typedef HashedFile<StreamStorage> StudentFile;
+typedef HashedFile<MappedStorage> MappedStudentFile;
+
+template <class File>
+bool openIndexes(File& sf) {
+    if (sf.openIndexes())
+        return true;
+    cout << "Cannot open the indexes of " << FILENAME << "\n";
+    return false;
+}
+
+// Opens students.dat, creating it on first run. A file in the old layout (100 records
+// back to back) is converted.
+template <class File>
+bool openStudents(File& sf) {
+    if (sf.open(FILENAME))
+        return openIndexes(sf);
+
+    vector<Student> old;
+    ifstream check(FILENAME, ios::binary);
+    char magic[8] = "";
+    check.read(magic, sizeof(magic));
+    if (check && strncmp(magic, FILE_MAGIC, 6) == 0) {
+        cout << FILENAME << " is a student file of another version or is damaged.\n";
+        return false;
+    }
+    check.clear();
+    check.seekg(0, ios::beg);
+    Student s;
+    while (check.read((char*)&s, sizeof(Student)))
+        if (s.rollNo != -1)
+            old.push_back(s);
+    check.close();
+
+    if (!sf.create(FILENAME, INITIAL_RECORDS))
+        return false;
+    for (const Student& o : old)
+        sf.insert(o);
+    if (!old.empty())
+        cout << "Converted " << old.size() << " records of students.dat to hashed buckets.\n";
+    else
+        cout << "Initialized student database.\n";
+    return openIndexes(sf);
+}
+
+// Adds a student to its roll number's bucket
+template <class File>
+void addStudent() {
+    File sf;
+    if (!openStudents(sf))
+        return;
+    Student s;
+    s.input();
+
+    if (sf.insert(s))
+        cout << "Student added successfully.\n";
+    else if (sf.failed)
+        cout << "Could not write " << FILENAME << ".\n";
+    else
+        cout << "Roll No " << s.rollNo << " already exists.\n";
 }
 
 // Searches student by roll number
+template <class File>
 void searchStudent() {
-    ifstream file(FILENAME, ios::binary);
+    File sf;
+    if (!openStudents(sf))
+        return;
     int roll;
     cout << "Enter Roll No to search: ";
     cin >> roll;
-    Student s;
-    bool found = false;
-
-    for (int i = 0; i < MAX; ++i) {
-        file.read((char*)&s, sizeof(Student));
-        if (s.rollNo == roll) {
-            s.display();
-            found = true;
-            break;
-        }
-    }
-
-    if (!found)
+    Bucket bucket;
+    Location at;
+
+    if (sf.find(roll, bucket, at))
+        bucket.slots[at.slot].display();
+    else if (sf.failed)
+        cout << "Could not read " << FILENAME << ".\n";
+    else
         cout << "Record not found.\n";
-
-    file.close();
 }
 
 // Deletes a student by roll number
+template <class File>
 void deleteStudent() {
-    fstream file(FILENAME, ios::in | ios::out | ios::binary);
+    File sf;
+    if (!openStudents(sf))
+        return;
     int roll;
     cout << "Enter Roll No to delete: ";
     cin >> roll;
-    Student s;
-    bool found = false;
-
-    for (int i = 0; i < MAX; ++i) {
-        file.seekg(i * sizeof(Student), ios::beg);
-        file.read((char*)&s, sizeof(Student));
-        if (s.rollNo == roll) {
-            Student blank;
-            file.seekp(i * sizeof(Student), ios::beg);
-            file.write((char*)&blank, sizeof(Student));
-            cout << "Record deleted.\n";
-            found = true;
-            break;
-        }
-    }
 
-    if (!found)
+    if (sf.remove(roll))
+        cout << "Record deleted.\n";
+    else if (sf.failed)
+        cout << "Could not write " << FILENAME << ".\n";
+    else
         cout << "Record not found.\n";
-
-    file.close();
 }
 
 // Edits a student by roll number
+template <class File>
 void editStudent() {
-    fstream file(FILENAME, ios::in | ios::out | ios::binary);
+    File sf;
+    if (!openStudents(sf))
+        return;
     int roll;
     cout << "Enter Roll No to edit: ";
     cin >> roll;
-    Student s;
-    bool found = false;
-
-    for (int i = 0; i < MAX; ++i) {
-        file.seekg(i * sizeof(Student), ios::beg);
-        file.read((char*)&s, sizeof(Student));
-        if (s.rollNo == roll) {
-            cout << "Existing Record:\n";
-            s.display();
-            cout << "Enter new details:\n";
-            s.input();
-            file.seekp(i * sizeof(Student), ios::beg);
-            file.write((char*)&s, sizeof(Student));
-            cout << "Record updated.\n";
-            found = true;
-            break;
+    Bucket bucket;
+    Location at;
+
+    if (!sf.find(roll, bucket, at)) {
+        if (sf.failed)
+            cout << "Could not read " << FILENAME << ".\n";
+        else
+            cout << "Record not found.\n";
+        return;
+    }
+    Student& s = bucket.slots[at.slot];
+    cout << "Existing Record:\n";
+    s.display();
+    cout << "Enter new details:\n";
+    s.input();
+    bool done;
+    if (s.rollNo == roll) {
+        done = sf.update(s);
+    } else {
+        // A new roll number belongs in another bucket
+        Student moved = s;
+        if (!sf.insert(moved)) {
+            if (sf.failed)
+                cout << "Could not write " << FILENAME << ".\n";
+            else
+                cout << "Roll No " << moved.rollNo << " already exists.\n";
+            return;
         }
+        done = sf.remove(roll);
     }
-
-    if (!found)
-        cout << "Record not found.\n";
-
-    file.close();
+    if (done)
+        cout << "Record updated.\n";
+    else
+        cout << "Could not write " << FILENAME << ".\n";
 }
 
 // Displays all students
+template <class File>
 void displayAll() {
-    ifstream file(FILENAME, ios::binary);
-    Student s;
+    File sf;
+    if (!openStudents(sf))
+        return;
     bool anyFound = false;
 
-    for (int i = 0; i < MAX; ++i) {
-        file.read((char*)&s, sizeof(Student));
-        if (s.rollNo != -1) {
-            s.display();
-            anyFound = true;
-        }
-    }
+    sf.forEach([&](Student s) {
+        s.display();
+        anyFound = true;
+    });
 
     if (!anyFound)
         cout << "No records to display.\n";
+}
 
-    file.close();
+// Searches students by exact name through the name index
+template <class File>
+void searchByName() {
+    File sf;
+    if (!openStudents(sf))
+        return;
+    char name[30];
+    cout << "Enter Name to search: ";
+    cin.ignore();
+    cin.getline(name, 30);
+    Bucket bucket;
+
+    vector<Location> found = sf.findByName(name);
+    for (const Location& at : found) {
+        if (sf.readBucket(at.bucket, bucket))
+            bucket.slots[at.slot].display();
+    }
+    if (found.empty())
+        cout << "Record not found.\n";
 }
 
-int main() {
-    // Create the file with 100 empty records only if it doesn't exist
-    ifstream check(FILENAME, ios::binary);
-    if (!check) {
-        ofstream file(FILENAME, ios::binary);
-        Student s;
-        for (int i = 0; i < MAX; ++i)
-            file.write((char*)&s, sizeof(Student));
-        file.close();
-        cout << "Initialized student database.\n";
+// Lists a division in roll number order through the division index
+template <class File>
+void listDivision() {
+    File sf;
+    if (!openStudents(sf))
+        return;
+    char division;
+    cout << "Enter Division: ";
+    cin >> division;
+    Bucket bucket;
+
+    vector<Location> found = sf.findByDivision(division);
+    for (const Location& at : found) {
+        if (sf.readBucket(at.bucket, bucket))
+            bucket.slots[at.slot].display();
     }
-    check.close();
+    cout << found.size() << " students in division " << division << ".\n";
+}
+
+// Lists the students with roll numbers in a range, in order, through the index
+template <class File>
+void listRange() {
+    File sf;
+    if (!openStudents(sf))
+        return;
+    int low, high;
+    cout << "Enter lowest and highest Roll No: ";
+    cin >> low >> high;
+    int listed = 0;
+
+    sf.forEachInRange(low, high, [&](Student s) {
+        s.display();
+        ++listed;
+    });
+
+    cout << listed << " students with Roll No " << low << " to " << high << ".\n";
+}
+
+// Loads n students into a fresh file, then counts bucket reads per lookup for stored and
+// absent roll numbers, and times in-place edits and a full scan. The old layout scanned
+// n / 2 records for a hit and all n for a miss.
+template <class File>
+void benchmark(const char* name, int n) {
+    mt19937 rng(42);
+    vector<int> rolls;
+    while ((int)rolls.size() < 2 * n) {
+        while ((int)rolls.size() < 2 * n)
+            rolls.push_back((int)(rng() >> 1));
+        sort(rolls.begin(), rolls.end());
+        rolls.erase(unique(rolls.begin(), rolls.end()), rolls.end());
+    }
+    shuffle(rolls.begin(), rolls.end(), rng);
+
+    File sf;
+    if (!sf.create(BENCH_FILENAME, INITIAL_RECORDS, false)) {
+        cout << "Cannot create " << BENCH_FILENAME << "\n";
+        return;
+    }
+    // About four students share each name; eight divisions
+    int nameCount = max(1, n / 4);
+    Student s;
+    strcpy(s.address, "Pune");
+    auto t0 = chrono::steady_clock::now();
+    for (int i = 0; i < n; ++i) {
+        s.rollNo = rolls[i];
+        snprintf(s.name, sizeof(s.name), "Student %d", i % nameCount);
+        s.division = (char)('A' + i % 8);
+        sf.insert(s);
+    }
+    auto t1 = chrono::steady_clock::now();
+    long long insertReads = sf.reads, insertWrites = sf.writes;
+
+    // Delete every tenth student and add as many new ones: emptied overflow buckets are reused
+    for (int i = 0; i < n; i += 10)
+        sf.remove(rolls[i]);
+    for (int i = 0; i < n; i += 10) {
+        s.rollNo = rolls[i];
+        sf.insert(s);
+    }
+
+    int lookups = min(n, 100000);
+    Bucket bucket;
+    Location at;
+    long long found = 0, before = sf.reads;
+    auto t2 = chrono::steady_clock::now();
+    for (int i = 0; i < lookups; ++i)
+        found += sf.find(rolls[rng() % n], bucket, at);
+    auto t3 = chrono::steady_clock::now();
+    long long hitReads = sf.reads - before;
+    before = sf.reads;
+    for (int i = n; i < n + lookups; ++i)
+        found += sf.find(rolls[i], bucket, at);
+    auto t4 = chrono::steady_clock::now();
+    long long missReads = sf.reads - before;
+
+    // Edits overwrite the bucket where they were found; one commit makes them durable
+    for (int i = 0; i < lookups; ++i) {
+        if (sf.find(rolls[rng() % n], bucket, at)) {
+            strcpy(bucket.slots[at.slot].address, "Mumbai");
+            sf.writeBucket(at.bucket, bucket);
+        }
+    }
+    sf.commit();
+    auto t5 = chrono::steady_clock::now();
+    long long scanned = 0;
+    sf.forEach([&](const Student&) { ++scanned; });
+    auto t6 = chrono::steady_clock::now();
+
+    // Remove and re-add students without the indexes, then build them and do the same with
+    // them kept up to date; then list ranges of about 100 roll numbers, look up names and
+    // list a division through them
+    int churn = min(n, 10000);
+    for (int i = 0; i < churn; ++i) {
+        sf.remove(rolls[i]);
+        s.rollNo = rolls[i];
+        sf.insert(s);
+    }
+    auto t7 = chrono::steady_clock::now();
+    sf.openIndexes();
+    auto t8 = chrono::steady_clock::now();
+    for (int i = 0; i < churn; ++i) {
+        sf.remove(rolls[i]);
+        s.rollNo = rolls[i];
+        sf.insert(s);
+    }
+    auto t9 = chrono::steady_clock::now();
+    int ranges = 1000;
+    long long width = 100LL * 0x7fffffff / n, listed = 0;
+    before = sf.reads;
+    for (int i = 0; i < ranges; ++i) {
+        int low = (int)(rng() >> 1);
+        sf.forEachInRange(low, (int)min(0x7fffffffLL, low + width - 1), [&](const Student&) { ++listed; });
+    }
+    auto t10 = chrono::steady_clock::now();
+    long long rangeReads = sf.reads - before;
+    int nameLookups = 1000;
+    long long named = 0;
+    before = sf.reads;
+    for (int i = 0; i < nameLookups; ++i) {
+        char wanted[30];
+        snprintf(wanted, sizeof(wanted), "Student %d", (int)(rng() % nameCount));
+        named += sf.findByName(wanted).size();
+    }
+    auto t11 = chrono::steady_clock::now();
+    long long nameReads = sf.reads - before;
+    vector<Location> division = sf.findByDivision('C');
+    auto t12 = chrono::steady_clock::now();
+    for (const Location& l : division)
+        sf.readBucket(l.bucket, bucket);
+    auto t13 = chrono::steady_clock::now();
+    const RollIndex& index = sf.rollIndex();
+
+    cout << "\n" << name << ": " << n << " records in " << sf.bucketCount() << " buckets + " << sf.overflowCount()
+         << " overflow buckets after growing " << sf.grows << " times from " << INITIAL_RECORDS << "\n";
+    cout << "Load: " << chrono::duration<double>(t1 - t0).count() << " s, "
+         << (double)insertReads / n << " reads and " << (double)insertWrites / n
+         << " writes per insert (rehashing included)\n";
+    cout << "Hit:  " << (double)hitReads / lookups << " reads/lookup, "
+         << chrono::duration<double, micro>(t3 - t2).count() / lookups << " us/lookup\n";
+    cout << "Miss: " << (double)missReads / lookups << " reads/lookup, "
+         << chrono::duration<double, micro>(t4 - t3).count() / lookups << " us/lookup\n";
+    cout << "Edit: " << chrono::duration<double, micro>(t5 - t4).count() / lookups << " us/edit (one commit)\n";
+    cout << "Scan: " << scanned << " records in " << chrono::duration<double, milli>(t6 - t5).count() << " ms\n";
+    cout << "Indexes: built in " << chrono::duration<double, milli>(t8 - t7).count() << " ms; roll number tree of height "
+         << index.height() << ", " << index.pages() << " + " << sf.nameIndex().pages() << " + "
+         << sf.divisionIndex().pages() << " pages of " << PAGE_SIZE << " bytes for roll number, name, division\n";
+    cout << "Upkeep: " << chrono::duration<double, micro>(t7 - t6).count() / churn << " us per delete + insert without indexes, "
+         << chrono::duration<double, micro>(t9 - t8).count() / churn << " us with them\n";
+    cout << "Range: " << (double)listed / ranges << " students, "
+         << chrono::duration<double, micro>(t10 - t9).count() / ranges << " us and "
+         << (double)rangeReads / ranges << " bucket reads per range (a scan reads " << sf.bucketCount() + sf.overflowCount()
+         << ")\n";
+    cout << "Name: " << (double)named / nameLookups << " students, "
+         << chrono::duration<double, micro>(t11 - t10).count() / nameLookups << " us and "
+         << (double)nameReads / nameLookups << " bucket reads per name\n";
+    cout << "Division: " << division.size() << " students of C located in "
+         << chrono::duration<double, milli>(t12 - t11).count() << " ms, read in "
+         << chrono::duration<double, milli>(t13 - t12).count() << " ms\n";
+    cout << "Found: " << found << " of " << lookups << " stored\n";
+    sf.close();
+    remove(BENCH_FILENAME);
+    for (const char* suffix : INDEX_SUFFIXES)
+        remove((string(BENCH_FILENAME) + suffix).c_str());
+}
 
+template <class File>
+void menu() {
     int choice;
     do {
         cout << "\n--- Student Information System ---\n";
-        cout << "1. Add Student\n2. Search Student\n3. Edit Student\n4. Delete Student\n5. Display All\n0. Exit\nEnter choice: ";
+        cout << "1. Add Student\n2. Search Student\n3. Edit Student\n4. Delete Student\n5. Display All\n6. List Roll No Range\n7. Search by Name\n8. List Division\n0. Exit\nEnter choice: ";
         cin >> choice;
         switch (choice) {
-            case 1: addStudent(); break;
-            case 2: searchStudent(); break;
-            case 3: editStudent(); break;
-            case 4: deleteStudent(); break;
-            case 5: displayAll(); break;
+            case 1: addStudent<File>(); break;
+            case 2: searchStudent<File>(); break;
+            case 3: editStudent<File>(); break;
+            case 4: deleteStudent<File>(); break;
+            case 5: displayAll<File>(); break;
+            case 6: listRange<File>(); break;
+            case 7: searchByName<File>(); break;
+            case 8: listDivision<File>(); break;
             case 0: cout << "Exiting...\n"; break;
             default: cout << "Invalid option!\n";
         }
     } while (choice != 0);
+}
+
+int main(int argc, char* argv[]) {
+    if (argc > 1 && strcmp(argv[1], "--mmap") == 0) {
+        menu<MappedStudentFile>();
+        return 0;
+    }
+    if (argc > 1) {
+        benchmark<StudentFile>("fstream", atoi(argv[1]));
+        benchmark<MappedStudentFile>("mmap", atoi(argv[1]));
+        return 0;
+    }
 
+    menu<StudentFile>();
     return 0;
 }
 
 
+
 // Your program is an excellent example of using **Direct Access Files (Random Access Files)** in C++ to manage a **fixed-size student record system**. Here's a detailed breakdown of what your program is doing:
 
 // ---
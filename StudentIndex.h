@@ -0,0 +1,561 @@
+// B+-tree indexes for the student files (Ass9.cpp, Ass17.cpp): the primary one on roll
+// number, and secondary ones on name and division.
+// A tree lives in its own file of PAGE_SIZE pages: page 0 is the header, every other page
+// a node. Inner nodes hold keys and child page numbers; leaves hold keys with the location
+// of their record (whatever the student file uses: a slot number, a byte offset) and a link
+// to the leaf on their right, so a range is one descent plus a walk along the leaves. Pages are read and written through a small buffer pool with clock eviction.
+// The index is derived data: the owner stamps it with the version of its student file on
+// close, and open() reports a stamp that does not match so the owner rebuilds it. While open
+// the stamp on disk is 0, so a crash leaves an index that is rebuilt next time.
+// Deletes do not merge leaves; an emptied leaf stays in the chain until the next rebuild.
+
+#ifndef STUDENT_INDEX_H
+#define STUDENT_INDEX_H
+
+#include <algorithm>
+#include <cstdint>
+#include <cstring>
+#include <string>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+#include <tuple>
+#include <fcntl.h>
+#include <unistd.h>
+
+const int PAGE_SIZE = 4096;
+const int POOL_PAGES = 64;
+const char INDEX_MAGIC[8] = "STUIDX1";
+
+// Key is any plain struct with operator<. The key count is kept even so the locations after
+// the keys stay 8-byte aligned.
+template <class Key>
+struct LeafPage {
+    static constexpr int CAPACITY = (int)((PAGE_SIZE - 16) / (sizeof(Key) + sizeof(int64_t))) & ~1;
+
+    int32_t leaf;       // 1
+    int32_t count;
+    int32_t next;       // leaf to the right, -1 for the last one
+    int32_t unused;
+    Key keys[CAPACITY];
+    int64_t locations[CAPACITY];
+};
+
+// children[i] holds the keys k with keys[i - 1] <= k < keys[i]
+template <class Key>
+struct InnerPage {
+    static constexpr int CAPACITY = (int)((PAGE_SIZE - 16 - sizeof(int32_t)) / (sizeof(Key) + sizeof(int32_t)));
+
+    int32_t leaf;       // 0
+    int32_t count;      // keys; there is one more child
+    int32_t next;
+    int32_t unused;
+    Key keys[CAPACITY];
+    int32_t children[CAPACITY + 1];
+};
+
+// Fixed number of page frames over a file. pin() returns a page held in memory until the
+// matching unpin(); unpinned frames are reused by the clock algorithm, writing them back if
+// they were changed.
+class BufferPool {
+    struct Frame {
+        int page = -1;
+        int pins = 0;
+        bool dirty = false;
+        bool referenced = false;
+    };
+
+    int fd = -1;
+    std::vector<Frame> frames;
+    std::vector<char> memory;
+    std::unordered_map<int, int> frameOf;
+    size_t hand = 0;
+
+    char* data(int f) { return &memory[(size_t)f * PAGE_SIZE]; }
+
+    void writeBack(int f) {
+        if (frames[f].dirty) {
+            if (pwrite(fd, data(f), PAGE_SIZE, (off_t)frames[f].page * PAGE_SIZE) != PAGE_SIZE)
+                failed = true;
+            frames[f].dirty = false;
+            ++writes;
+        }
+    }
+
+    // A frame to load a page into: unpinned, and not used since the hand last passed it
+    int victim() {
+        for (size_t turns = 0; turns < 2 * frames.size() + 1; ++turns) {
+            int f = (int)hand;
+            hand = (hand + 1) % frames.size();
+            if (frames[f].pins > 0)
+                continue;
+            if (frames[f].referenced) {
+                frames[f].referenced = false;
+                continue;
+            }
+            writeBack(f);
+            if (frames[f].page != -1)
+                frameOf.erase(frames[f].page);
+            return f;
+        }
+        return -1;
+    }
+
+public:
+    long long reads = 0;    // pages read from and written to the file
+    long long writes = 0;
+    bool failed = false;    // a page write failed
+
+    BufferPool(int pages = POOL_PAGES) : frames(pages), memory((size_t)pages * PAGE_SIZE) {}
+
+    void attach(int file) {
+        fd = file;
+        failed = false;
+        frameOf.clear();
+        for (Frame& f : frames)
+            f = Frame();
+    }
+
+    // Page in memory, read from the file unless fresh (a new page, zeroed). nullptr if
+    // every frame is pinned.
+    char* pin(int page, bool fresh = false) {
+        auto it = frameOf.find(page);
+        int f;
+        if (it != frameOf.end()) {
+            f = it->second;
+        } else {
+            f = victim();
+            if (f == -1)
+                return nullptr;
+            frames[f].page = page;
+            frameOf[page] = f;
+            if (fresh) {
+                memset(data(f), 0, PAGE_SIZE);
+                frames[f].dirty = true;
+            } else {
+                ssize_t n = pread(fd, data(f), PAGE_SIZE, (off_t)page * PAGE_SIZE);
+                memset(data(f) + std::max<ssize_t>(n, 0), 0, PAGE_SIZE - std::max<ssize_t>(n, 0));
+                ++reads;
+            }
+        }
+        ++frames[f].pins;
+        frames[f].referenced = true;
+        return data(f);
+    }
+
+    void unpin(int page, bool dirty) {
+        Frame& f = frames[frameOf[page]];
+        --f.pins;
+        f.dirty = f.dirty || dirty;
+    }
+
+    // Writes every changed page back; the pages stay cached
+    void flush() {
+        for (size_t f = 0; f < frames.size(); ++f)
+            writeBack((int)f);
+    }
+};
+
+template <class Key>
+class BTreeIndex {
+    typedef LeafPage<Key> Leaf;
+    typedef InnerPage<Key> Inner;
+    typedef std::pair<Key, int64_t> Entry;
+
+    static_assert(sizeof(Leaf) <= PAGE_SIZE, "leaf does not fit a page");
+    static_assert(sizeof(Inner) <= PAGE_SIZE, "inner node does not fit a page");
+
+    struct Header {
+        char magic[8];
+        uint64_t stamp;     // version of the student file this index matches, 0 while open
+        int32_t root;
+        int32_t height;     // 1 when the root is a leaf
+        int32_t pageCount;
+        int32_t keySize;
+        int64_t entries;
+    };
+
+    // Separator and new right page of a node that split, page -1 if it did not
+    struct Split {
+        Key key;
+        int32_t page;
+    };
+
+    int fd = -1;
+    Header header;
+    uint64_t stamp = 0;
+    BufferPool pool;
+
+    Leaf* pinLeaf(int page) { return (Leaf*)pool.pin(page); }
+    Inner* pinInner(int page) { return (Inner*)pool.pin(page); }
+
+    static bool same(const Key& a, const Key& b) { return !(a < b) && !(b < a); }
+
+    int allocate() {
+        int page = header.pageCount++;
+        pool.pin(page, true);
+        pool.unpin(page, true);
+        return page;
+    }
+
+    bool writeHeader() {
+        char page[PAGE_SIZE] = {};
+        memcpy(page, &header, sizeof(header));
+        return pwrite(fd, page, PAGE_SIZE, 0) == PAGE_SIZE;
+    }
+
+    // Leaf that holds or would hold key
+    int findLeaf(const Key& key) {
+        int page = header.root;
+        for (int level = header.height; level > 1; --level) {
+            Inner* node = pinInner(page);
+            int i = (int)(std::upper_bound(node->keys, node->keys + node->count, key) - node->keys);
+            int child = node->children[i];
+            pool.unpin(page, false);
+            page = child;
+        }
+        return page;
+    }
+
+    bool insertInto(int page, int level, const Key& key, int64_t location, Split& split) {
+        if (level == 1) {
+            Leaf* leaf = pinLeaf(page);
+            int i = (int)(std::lower_bound(leaf->keys, leaf->keys + leaf->count, key) - leaf->keys);
+            if (i < leaf->count && same(leaf->keys[i], key)) {
+                pool.unpin(page, false);
+                return false;
+            }
+            if (leaf->count < Leaf::CAPACITY) {
+                std::copy_backward(leaf->keys + i, leaf->keys + leaf->count, leaf->keys + leaf->count + 1);
+                std::copy_backward(leaf->locations + i, leaf->locations + leaf->count, leaf->locations + leaf->count + 1);
+                leaf->keys[i] = key;
+                leaf->locations[i] = location;
+                ++leaf->count;
+                pool.unpin(page, true);
+                return true;
+            }
+
+            // Full: the upper half moves to a new leaf linked in to the right
+            int rightPage = allocate();
+            Leaf* right = pinLeaf(rightPage);
+            int half = (Leaf::CAPACITY + 1) / 2;
+            int moved = Leaf::CAPACITY - half;
+            std::copy(leaf->keys + half, leaf->keys + Leaf::CAPACITY, right->keys);
+            std::copy(leaf->locations + half, leaf->locations + Leaf::CAPACITY, right->locations);
+            right->leaf = 1;
+            right->count = moved;
+            right->next = leaf->next;
+            leaf->count = half;
+            leaf->next = rightPage;
+            Leaf* into = i <= half ? leaf : right;
+            int at = i <= half ? i : i - half;
+            std::copy_backward(into->keys + at, into->keys + into->count, into->keys + into->count + 1);
+            std::copy_backward(into->locations + at, into->locations + into->count, into->locations + into->count + 1);
+            into->keys[at] = key;
+            into->locations[at] = location;
+            ++into->count;
+            split = {right->keys[0], rightPage};
+            pool.unpin(rightPage, true);
+            pool.unpin(page, true);
+            return true;
+        }
+
+        // Inner node: not kept pinned while the child is changed
+        Inner* node = pinInner(page);
+        int i = (int)(std::upper_bound(node->keys, node->keys + node->count, key) - node->keys);
+        int child = node->children[i];
+        pool.unpin(page, false);
+        Split below = {Key(), -1};
+        if (!insertInto(child, level - 1, key, location, below))
+            return false;
+        if (below.page == -1)
+            return true;
+
+        node = pinInner(page);
+        if (node->count < Inner::CAPACITY) {
+            std::copy_backward(node->keys + i, node->keys + node->count, node->keys + node->count + 1);
+            std::copy_backward(node->children + i + 1, node->children + node->count + 1, node->children + node->count + 2);
+            node->keys[i] = below.key;
+            node->children[i + 1] = below.page;
+            ++node->count;
+            pool.unpin(page, true);
+            return true;
+        }
+
+        // Full: lay out all keys and children with the new one, keep the lower half, move
+        // the upper half right and pass the middle key up
+        std::vector<Key> keys(node->keys, node->keys + node->count);
+        std::vector<int32_t> children(node->children, node->children + node->count + 1);
+        keys.insert(keys.begin() + i, below.key);
+        children.insert(children.begin() + i + 1, below.page);
+        int mid = (int)keys.size() / 2;
+        int rightPage = allocate();
+        Inner* right = pinInner(rightPage);
+        node->count = mid;
+        std::copy(keys.begin(), keys.begin() + mid, node->keys);
+        std::copy(children.begin(), children.begin() + mid + 1, node->children);
+        right->count = (int)keys.size() - mid - 1;
+        std::copy(keys.begin() + mid + 1, keys.end(), right->keys);
+        std::copy(children.begin() + mid + 1, children.end(), right->children);
+        right->next = -1;
+        split = {keys[mid], rightPage};
+        pool.unpin(rightPage, true);
+        pool.unpin(page, true);
+        return true;
+    }
+
+public:
+    BTreeIndex(int poolPages = POOL_PAGES) : pool(poolPages) {
+        memset(&header, 0, sizeof(header));
+    }
+
+    ~BTreeIndex() { close(); }
+
+    bool isOpen() const { return fd != -1; }
+
+    // Opens an index built for the student file version stamp. False if it is missing,
+    // damaged or stale: the owner then rebuilds it with create().
+    bool open(const std::string& path, uint64_t fileStamp) {
+        close();
+        fd = ::open(path.c_str(), O_RDWR);
+        if (fd == -1)
+            return false;
+        if (pread(fd, &header, sizeof(header), 0) != (ssize_t)sizeof(header)
+            || memcmp(header.magic, INDEX_MAGIC, sizeof(header.magic)) != 0 || header.keySize != (int32_t)sizeof(Key)
+            || header.stamp != fileStamp || header.stamp == 0) {
+            ::close(fd);
+            fd = -1;
+            return false;
+        }
+        stamp = fileStamp;
+        header.stamp = 0;
+        if (!writeHeader() || fdatasync(fd) != 0) {
+            ::close(fd);
+            fd = -1;
+            return false;
+        }
+        pool.attach(fd);
+        return true;
+    }
+
+    // Writes a new index of the (key, location) pairs, in any order. Where a key appears
+    // more than once the first pair wins. Leaves are filled to 90% so later inserts do not
+    // split them straight away.
+    bool create(const std::string& path, std::vector<Entry> entries, uint64_t fileStamp) {
+        close();
+        fd = ::open(path.c_str(), O_RDWR | O_CREAT | O_TRUNC, 0644);
+        if (fd == -1)
+            return false;
+        std::stable_sort(entries.begin(), entries.end(),
+                         [](const Entry& a, const Entry& b) { return a.first < b.first; });
+        entries.erase(std::unique(entries.begin(), entries.end(),
+                                  [](const Entry& a, const Entry& b) { return same(a.first, b.first); }),
+                      entries.end());
+
+        memset(&header, 0, sizeof(header));
+        memcpy(header.magic, INDEX_MAGIC, sizeof(header.magic));
+        header.pageCount = 1;
+        header.keySize = (int32_t)sizeof(Key);
+        header.entries = (int64_t)entries.size();
+        stamp = fileStamp;
+        pool.attach(fd);
+        if (!writeHeader()) {
+            ::close(fd);
+            fd = -1;
+            return false;
+        }
+
+        // Leaves left to right, then each level of inner nodes over the one below, until
+        // one node is left: the root. A level is a list of (first key, page).
+        std::vector<std::pair<Key, int32_t>> level;
+        size_t perLeaf = Leaf::CAPACITY * 9 / 10;
+        size_t i = 0;
+        do {
+            int page = allocate();
+            Leaf* leaf = pinLeaf(page);
+            leaf->leaf = 1;
+            leaf->next = -1;
+            size_t end = std::min(entries.size(), i + perLeaf);
+            for (; i < end; ++i) {
+                leaf->keys[leaf->count] = entries[i].first;
+                leaf->locations[leaf->count++] = entries[i].second;
+            }
+            if (!level.empty()) {
+                Leaf* prev = pinLeaf(level.back().second);
+                prev->next = page;
+                pool.unpin(level.back().second, true);
+            }
+            level.push_back({leaf->count ? leaf->keys[0] : Key(), page});
+            pool.unpin(page, true);
+        } while (i < entries.size());
+        header.height = 1;
+
+        size_t perInner = Inner::CAPACITY * 9 / 10;
+        while (level.size() > 1) {
+            std::vector<std::pair<Key, int32_t>> above;
+            size_t first = 0;
+            while (first < level.size()) {
+                size_t last = std::min(level.size(), first + perInner + 1);
+                // Do not leave a lone child for the last node
+                if (level.size() - last == 1)
+                    --last;
+                int page = allocate();
+                Inner* node = pinInner(page);
+                node->next = -1;
+                node->children[0] = level[first].second;
+                for (size_t c = first + 1; c < last; ++c) {
+                    node->keys[node->count] = level[c].first;
+                    node->children[++node->count] = level[c].second;
+                }
+                above.push_back({level[first].first, page});
+                pool.unpin(page, true);
+                first = last;
+            }
+            level.swap(above);
+            ++header.height;
+        }
+        header.root = level[0].second;
+        return true;
+    }
+
+    // Writes the cached pages, then the header stamped with the file version it matches
+    void close() {
+        if (fd == -1)
+            return;
+        pool.flush();
+        if (!pool.failed && fdatasync(fd) == 0) {
+            header.stamp = stamp;
+            writeHeader();
+        }
+        ::close(fd);
+        fd = -1;
+    }
+
+    // Version of the student file the index will be stamped with on close
+    void setStamp(uint64_t fileStamp) { stamp = fileStamp; }
+
+    bool find(const Key& key, int64_t& location) {
+        int page = findLeaf(key);
+        Leaf* leaf = pinLeaf(page);
+        int i = (int)(std::lower_bound(leaf->keys, leaf->keys + leaf->count, key) - leaf->keys);
+        bool found = i < leaf->count && same(leaf->keys[i], key);
+        if (found)
+            location = leaf->locations[i];
+        pool.unpin(page, false);
+        return found;
+    }
+
+    // Adds key unless it is already indexed
+    bool insert(const Key& key, int64_t location) {
+        Split split = {Key(), -1};
+        if (!insertInto(header.root, header.height, key, location, split))
+            return false;
+        if (split.page != -1) {
+            // The root split: a new root above the two halves
+            int page = allocate();
+            Inner* root = pinInner(page);
+            root->count = 1;
+            root->next = -1;
+            root->keys[0] = split.key;
+            root->children[0] = header.root;
+            root->children[1] = split.page;
+            pool.unpin(page, true);
+            header.root = page;
+            ++header.height;
+        }
+        ++header.entries;
+        return true;
+    }
+
+    bool remove(const Key& key) {
+        int page = findLeaf(key);
+        Leaf* leaf = pinLeaf(page);
+        int i = (int)(std::lower_bound(leaf->keys, leaf->keys + leaf->count, key) - leaf->keys);
+        bool found = i < leaf->count && same(leaf->keys[i], key);
+        if (found) {
+            std::copy(leaf->keys + i + 1, leaf->keys + leaf->count, leaf->keys + i);
+            std::copy(leaf->locations + i + 1, leaf->locations + leaf->count, leaf->locations + i);
+            --leaf->count;
+            --header.entries;
+        }
+        pool.unpin(page, found);
+        return found;
+    }
+
+    // Calls f(key, location) for every key in [low, high], in increasing order
+    template <class F>
+    void range(const Key& low, const Key& high, F f) {
+        int page = findLeaf(low);
+        while (page != -1) {
+            Leaf* leaf = pinLeaf(page);
+            int i = (int)(std::lower_bound(leaf->keys, leaf->keys + leaf->count, low) - leaf->keys);
+            bool past = false;
+            for (; i < leaf->count; ++i) {
+                if (high < leaf->keys[i]) {
+                    past = true;
+                    break;
+                }
+                f(leaf->keys[i], leaf->locations[i]);
+            }
+            int next = leaf->next;
+            pool.unpin(page, false);
+            page = past ? -1 : next;
+        }
+    }
+
+    long long size() const { return header.entries; }
+    int height() const { return header.height; }
+    int pages() const { return header.pageCount; }
+    long long pageReads() const { return pool.reads; }
+    long long pageWrites() const { return pool.writes; }
+};
+
+typedef BTreeIndex<int32_t> RollIndex;
+
+// Secondary keys carry the roll number, so a student's entry is unique and can be found
+// again to delete it; all students with one name or division form a range.
+
+// Hash index on name: names are ordered by a 32-bit hash, so equal names sit together.
+// Different names can share a hash; readers compare the name in the record.
+struct NameKey {
+    uint32_t hash;
+    int32_t rollNo;
+
+    bool operator<(const NameKey& o) const { return std::tie(hash, rollNo) < std::tie(o.hash, o.rollNo); }
+};
+
+// Sorted index on division, then roll number. Divisions compare on their first 8 bytes.
+struct DivisionKey {
+    char division[8];
+    int32_t rollNo;
+
+    bool operator<(const DivisionKey& o) const {
+        int c = memcmp(division, o.division, sizeof(division));
+        return c != 0 ? c < 0 : rollNo < o.rollNo;
+    }
+};
+
+typedef BTreeIndex<NameKey> NameIndex;
+typedef BTreeIndex<DivisionKey> DivisionIndex;
+
+// FNV-1a
+inline uint32_t nameHash(const std::string& name) {
+    uint32_t h = 2166136261u;
+    for (char c : name)
+        h = (h ^ (unsigned char)c) * 16777619u;
+    return h;
+}
+
+inline NameKey nameKey(const std::string& name, int rollNo) {
+    return NameKey{nameHash(name), rollNo};
+}
+
+inline DivisionKey divisionKey(const std::string& division, int rollNo) {
+    DivisionKey key;
+    memset(&key, 0, sizeof(key));
+    memcpy(key.division, division.data(), std::min(division.size(), sizeof(key.division)));
+    key.rollNo = rollNo;
+    return key;
+}
+
+#endif